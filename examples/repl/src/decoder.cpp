@@ -12,6 +12,10 @@ Decoder::Decoder() {
   _cvs[8uz - 1uz] = DCC_MANUFACTURER_ID; // Manufacturer ID
 }
 
+void Decoder::waitForPacket(std::chrono::milliseconds timeout) {
+  _packet_queued.try_acquire_for(timeout);
+}
+
 void Decoder::direction(uint16_t addr, bool dir) {
   cli::Cli::cout() << "Address " << addr << ": set direction "
                    << (dir ? "forward" : "backward") << PROMPTENDL;
@@ -70,3 +74,5 @@ bool Decoder::writeCv(uint32_t cv_addr, bool bit, uint32_t pos) {
                    << PROMPTENDL;
   return red_bit;
 }
+
+void Decoder::packetQueued() { _packet_queued.release(); }
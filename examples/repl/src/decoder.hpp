@@ -1,12 +1,17 @@
 #pragma once
 
+#include <chrono>
 #include <dcc/dcc.hpp>
+#include <semaphore>
 
 struct Decoder : dcc::rx::CrtpBase<Decoder> {
   friend dcc::rx::CrtpBase<Decoder>;
 
   Decoder();
 
+  // Wait until a packet got queued or timeout passed
+  void waitForPacket(std::chrono::milliseconds timeout);
+
 private:
   // Set direction (1 forward, 0 backward)
   void direction(uint16_t addr, bool dir);
@@ -26,6 +31,9 @@ private:
   // Transmit BiDi
   void transmitBiDi(std::span<uint8_t const> bytes);
 
+  // Packet got queued (called from interrupt)
+  void packetQueued();
+
   // Read CV
   uint8_t readCv(uint32_t cv_addr, uint8_t byte = 0u);
 
@@ -39,4 +47,5 @@ private:
   bool writeCv(uint32_t cv_addr, bool bit, uint32_t pos);
 
   std::array<uint8_t, 1024uz> _cvs{};
+  std::binary_semaphore _packet_queued{0};
 };
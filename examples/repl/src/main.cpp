@@ -24,9 +24,9 @@ void decoder_task() {
   // Register to timer interrupt
   timer_irq_handler = [&decoder](uint32_t ccr) { decoder.receive(ccr); };
 
-  // Continuously call execute
+  // Call execute as soon as a packet got queued
   for (;;) {
-    std::this_thread::sleep_for(5ms);
+    decoder.waitForPacket(5ms);
     decoder.execute();
   }
 }
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <iterator>
@@ -55,47 +56,88 @@ struct Address {
   bool reversed{}; /// Direction reversed
 };
 
+/// Address type and size derived from first byte of a packet
+struct Header {
+  decltype(Address::type) type{}; ///< Address type
+  uint8_t size{}; ///< Size of address in bytes (=offset of instruction byte)
+};
+
+namespace detail {
+
+/// Lookup table of headers
+///
+/// The type of accessory addresses depends on the second byte and is always
+/// BasicAccessory in here.
+inline constexpr auto headers{[] {
+  std::array<Header, 256uz> retval{};
+  for (auto i{0uz}; i < size(retval); ++i)
+    // 0
+    if (i == 0uz) retval[i] = {Address::Broadcast, 1u};
+    // 1-127
+    else if (i <= 127uz) retval[i] = {Address::BasicLoco, 1u};
+    // 128-191
+    else if (i <= 191uz) retval[i] = {Address::BasicAccessory, 2u};
+    // 192-231
+    else if (i <= 231uz) retval[i] = {Address::ExtendedLoco, 2u};
+    // 232-252
+    else if (i <= 252uz) retval[i] = {Address::Reserved, 2u};
+    // 253
+    else if (i == 253uz) retval[i] = {Address::DataTransfer, 1u};
+    // 254
+    else if (i == 254uz) retval[i] = {Address::AutomaticLogon, 1u};
+    // 255
+    else retval[i] = {Address::Idle, 1u};
+  return retval;
+}()};
+
+} // namespace detail
+
+/// Decode header
+///
+/// \param  byte  First byte of packet
+/// \return Header
+constexpr Header decode_header(uint8_t byte) { return detail::headers[byte]; }
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Warray-bounds"
-/// Decode address
+/// Decode address of already decoded header
 ///
 /// \tparam InputIt std::input_iterator
+/// \param  header  Header of first byte
 /// \param  first   Beginning of the range to decode from
 /// \return Address
 template<std::input_iterator InputIt>
-constexpr Address decode_address(InputIt first) {
-  // 0
-  if (*first == 0u) return {*first, Address::Broadcast};
-  // 1-127
-  else if (*first <= 127u) return {*first, Address::BasicLoco};
-  // 128-191
-  else if (*first <= 191u) {
-    auto const a7_2{(*first++ & 0x3Fu) << 2u};
-    auto const a10_8{(~*first & 0x70u) << 4u};
-    auto const a1_0{(*first >> 1u) & 0x03u};
-    return {static_cast<Address::value_type>(a10_8 | a7_2 | a1_0),
-            *first & 0b1000'0000u ? Address::BasicAccessory
-                                  : Address::ExtendedAccessory};
-  }
-  // 192-231
-  else if (*first <= 231u) {
-    auto const a13_8{(*first++ & 0b0011'1111u) << 8u};
-    auto const a7_0{*first};
-    return {static_cast<Address::value_type>(a13_8 | a7_0),
-            Address::ExtendedLoco};
+constexpr Address decode_address(Header header, InputIt first) {
+  switch (auto const type{header.type}; type) {
+    case Address::BasicAccessory: {
+      auto const a7_2{(*first++ & 0x3Fu) << 2u};
+      auto const a10_8{(~*first & 0x70u) << 4u};
+      auto const a1_0{(*first >> 1u) & 0x03u};
+      return {static_cast<Address::value_type>(a10_8 | a7_2 | a1_0),
+              *first & 0b1000'0000u ? Address::BasicAccessory
+                                    : Address::ExtendedAccessory};
+    }
+    case Address::ExtendedLoco: {
+      auto const a13_8{(*first++ & 0b0011'1111u) << 8u};
+      auto const a7_0{*first};
+      return {static_cast<Address::value_type>(a13_8 | a7_0),
+              Address::ExtendedLoco};
+    }
+    default: return {*first, type};
   }
-  // 232-252
-  else if (*first <= 252u)
-    return {*first, Address::Reserved};
-  // 253
-  else if (*first == 253u) return {*first, Address::DataTransfer};
-  // 254
-  else if (*first == 254u) return {*first, Address::AutomaticLogon};
-  // 255
-  else return {*first, Address::Idle};
 }
 #pragma GCC diagnostic pop
 
+/// Decode address
+///
+/// \tparam InputIt std::input_iterator
+/// \param  first   Beginning of the range to decode from
+/// \return Address
+template<std::input_iterator InputIt>
+constexpr Address decode_address(InputIt first) {
+  return decode_address(decode_header(*first), first);
+}
+
 /// Decode address
 ///
 /// \param  bytes Raw bytes
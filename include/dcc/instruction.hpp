@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <span>
+#include "address.hpp"
 #include "packet.hpp"
 
 namespace dcc {
@@ -72,8 +73,7 @@ constexpr Instruction decode_instruction(std::span<uint8_t const> bytes) {
 /// \param  packet  Packet
 /// \return Instruction
 constexpr Instruction decode_instruction(Packet const& packet) {
-  auto const offset{packet[0uz] >= 128u && packet[0uz] <= 252u};
-  return decode_instruction(cbegin(packet) + 1 + offset);
+  return decode_instruction(cbegin(packet) + decode_header(packet[0uz]).size);
 }
 
 } // namespace dcc
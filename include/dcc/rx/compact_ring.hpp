@@ -0,0 +1,128 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Compact ring buffer
+///
+/// \file   dcc/rx/compact_ring.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include "../packet.hpp"
+#include "ring.hpp"
+
+namespace dcc::rx {
+
+/// Single-producer/single-consumer ring buffer which stores packets back to
+/// back
+///
+/// Each packet takes its size plus a single length byte, so short packets
+/// don't waste the capacity of a whole Packet. The interface mirrors \ref Ring.
+/// The producer fills a staging packet through \ref next, which gets copied
+/// into the ring on \ref commit. The consumer gets a copy of the first packet
+/// which is only refreshed after \ref pop_front.
+///
+/// \tparam N   Capacity in bytes (power of 2)
+/// \tparam Smp Producer and consumer run on different cores
+template<size_t N, bool Smp = false>
+struct CompactRing {
+  static_assert(std::has_single_bit(N), "Capacity must be a power of 2");
+  static_assert(N > DCC_MAX_PACKET_SIZE, "Capacity must fit a packet");
+
+  using value_type = Packet;
+  using size_type = size_t;
+
+  /// Staging packet (producer)
+  ///
+  /// \return Staging packet
+  Packet& next() { return _next; }
+
+  /// Copy staging packet into the ring (producer)
+  void commit() {
+    auto tail{_tail.load(std::memory_order_relaxed)};
+    _data[tail++ & (N - 1uz)] = static_cast<uint8_t>(_next.size());
+    for (auto const byte : _next) _data[tail++ & (N - 1uz)] = byte;
+    detail::store<Smp>(_tail, tail);
+    detail::store<Smp>(_pushed,
+                       _pushed.load(std::memory_order_relaxed) + 1uz);
+  }
+
+  /// Copy packet into the ring (producer)
+  ///
+  /// \param  packet  Packet
+  void push_back(Packet const& packet) {
+    next() = packet;
+    commit();
+  }
+
+  /// Access first packet (consumer)
+  ///
+  /// \return Copy of first packet
+  Packet const& front() const {
+    if (!_front_valid) {
+      auto head{_head.load(std::memory_order_relaxed)};
+      _front.resize(_data[head++ & (N - 1uz)]);
+      for (auto& byte : _front) byte = _data[head++ & (N - 1uz)];
+      _front_valid = true;
+    }
+    return _front;
+  }
+
+  /// Remove first packet (consumer)
+  void pop_front() {
+    auto const head{_head.load(std::memory_order_relaxed)};
+    _front_valid = false;
+    detail::store<Smp>(_head, head + 1uz + _data[head & (N - 1uz)]);
+    detail::store<Smp>(_popped,
+                       _popped.load(std::memory_order_relaxed) + 1uz);
+  }
+
+  /// Remove all packets (consumer)
+  void clear() {
+    while (!empty(*this)) pop_front();
+  }
+
+  /// Number of packets
+  ///
+  /// \return Number of packets
+  size_type size() const {
+    auto const popped{detail::load<Smp>(_popped)};
+    return detail::load<Smp>(_pushed) - popped;
+  }
+
+  /// Capacity in bytes
+  ///
+  /// \return Capacity in bytes
+  static constexpr size_type capacity() { return N; }
+
+  friend size_type size(CompactRing const& r) { return r.size(); }
+
+  friend bool empty(CompactRing const& r) {
+    return detail::load<Smp>(r._head) == detail::load<Smp>(r._tail);
+  }
+
+  /// Check if staging packet doesn't fit (producer)
+  friend bool full(CompactRing const& r) {
+    auto const used{detail::load<Smp>(r._tail) - detail::load<Smp>(r._head)};
+    return N - used < 1uz + r._next.size();
+  }
+
+private:
+  std::array<uint8_t, N> _data{};
+  Packet _next{};
+  mutable Packet _front{};
+  mutable bool _front_valid{};
+  std::atomic<size_type> _head{};   ///< Written by consumer
+  std::atomic<size_type> _tail{};   ///< Written by producer
+  std::atomic<size_type> _popped{}; ///< Written by consumer
+  std::atomic<size_type> _pushed{}; ///< Written by producer
+};
+
+} // namespace dcc::rx
@@ -0,0 +1,142 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Receive configuration
+///
+/// \file   dcc/rx/config.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "../instruction.hpp"
+#include "timing.hpp"
+
+namespace dcc::rx {
+
+/// Mask of instructions
+///
+/// \tparam  Is  Instructions
+template<Instruction... Is>
+inline constexpr uint32_t instruction_mask{
+  ((1u << std::to_underlying(Is)) | ... | 0u)};
+
+/// Behavior if a packet is received while the deque is full
+enum struct Overflow : uint8_t {
+  DropNewest, ///< Drop received packet
+  DropOldest, ///< Drop oldest packet which isn't getting executed
+  Replace,    ///< Replace oldest packet with same command, or drop oldest
+};
+
+/// Protocol features compiled into the receiver
+///
+/// Logon, tip-off search and dyn datagrams are only available with BiDi.
+struct Features {
+  bool bidi{true};         ///< BiDi channel 1 and 2 (RCN-217)
+  bool logon{true};        ///< Automatic logon (RCN-218)
+  bool tip_off{true};      ///< Tip-off search
+  bool dyn{true};          ///< Dyn datagrams
+  bool pom{true};          ///< CV access in operations mode
+  bool service_mode{true}; ///< Service mode (RCN-216)
+};
+
+/// Compile-time configuration of receiver
+struct Config {
+  /// Timing windows for half a bit
+  TimingWindows timing_windows{};
+
+  /// Width of glitch filter in µs (0 to disable)
+  ///
+  /// Times shorter than this are considered glitches and get merged into the
+  /// following time before being classified.
+  uint32_t glitch_filter{};
+
+  /// Tolerance around learned bit timings in µs (0 to disable)
+  ///
+  /// Learns the bit timings of the command station from the preamble and
+  /// classifies the following bits against windows of this tolerance around
+  /// them. Both halves of a bit are learned separately, so asymmetric bits
+  /// don't require a larger tolerance.
+  uint32_t adaptive_timing{};
+
+  /// Number of inputs
+  ///
+  /// Each input has its own bit level state but all of them feed the same
+  /// packet deque. Identical packets received on multiple inputs are only
+  /// executed once.
+  size_t inputs{1uz};
+
+  /// Record histogram of received half bit timings
+  bool histogram{};
+
+  /// Count receive errors and packets
+  bool statistics{};
+
+  /// Window of quality of service in packets (power of 2)
+  size_t qos_window{16uz};
+
+  /// Drop packets which aren't of interest before they enter the deque
+  ///
+  /// Only packets for the primary, consist or logon address, broadcasts and
+  /// service mode packets are queued. As long as packets which might change
+  /// those addresses are queued, all packets are.
+  bool address_filter{};
+
+  /// Coalesce repetitions of the newest packet in the deque
+  ///
+  /// Identical packets increment a counter instead of taking another slot.
+  /// Each repetition still gets executed.
+  bool coalesce{};
+
+  /// Execute own and broadcast emergency stops before any queued packet
+  ///
+  /// Speed packets queued before the emergency stop get skipped.
+  bool priority_estop{};
+
+  /// Mask of instructions executed in handler mode (interrupt context)
+  ///
+  /// Only speed and direction, function group, feature expansion and advanced
+  /// operations instructions are supported. Packets executed in handler mode
+  /// don't enter the deque. As long as thread mode still has to execute queued
+  /// packets which share state with them (e.g. 126 speed steps if only speed
+  /// and direction is in the mask), CV access, consist control or decoder
+  /// control, they get queued as well.
+  uint32_t handler_mode{};
+
+  /// Handler mode and thread mode run on different cores
+  ///
+  /// Adds hardware memory barriers to the packet deque and packet end. Can't
+  /// be combined with the histogram, statistics, the address filter,
+  /// coalescing, the emergency stop priority slot, handler mode or an overflow
+  /// policy other than Overflow::DropNewest. Their state is shared between
+  /// both modes without synchronization.
+  bool smp{};
+
+  /// Behavior if a packet is received while the deque is full
+  Overflow overflow{Overflow::DropNewest};
+
+  /// Capacity of a compact deque in bytes (power of 2, 0 to disable)
+  ///
+  /// Replaces the DCC_RX_DEQUE_SIZE slots of DCC_MAX_PACKET_SIZE bytes by a
+  /// ring which stores packets back to back with a single length byte each.
+  /// Can't be combined with coalescing or an overflow policy other than
+  /// Overflow::DropNewest.
+  size_t compact_deque{};
+
+  /// Alignment of the state accessed in handler mode
+  ///
+  /// Should match the cache line of the data cache or flash accelerator
+  /// (e.g. 32 bytes on Cortex-M7 or ESP32).
+  size_t cache_line{32uz};
+
+  /// Protocol features
+  ///
+  /// Features which are turned off get removed together with their state.
+  Features features{};
+};
+
+} // namespace dcc::rx
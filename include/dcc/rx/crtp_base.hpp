@@ -10,9 +10,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <chrono>
 #include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
 #include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <ztl/bits.hpp>
 #include <ztl/inplace_deque.hpp>
 #include "../addresses.hpp"
@@ -23,6 +32,7 @@
 #include "../bidi/kmh.hpp"
 #include "../bidi/nak.hpp"
 #include "../bidi/temperature.hpp"
+#include "../bidi/timing.hpp"
 #include "../bidi/track_voltage.hpp"
 #include "../crc8.hpp"
 #include "../direction.hpp"
@@ -33,10 +43,19 @@
 #include "async_readable.hpp"
 #include "async_writable.hpp"
 #include "backoff.hpp"
+#include "config.hpp"
+#include "compact_ring.hpp"
+#include "cutout.hpp"
 #include "decoder.hpp"
 #include "east_west.hpp"
 #include "high_current.hpp"
+#include "histogram.hpp"
+#include "packet_queued.hpp"
+#include "qos.hpp"
+#include "ring.hpp"
+#include "statistics.hpp"
 #include "timing.hpp"
+#include "timing_tracker.hpp"
 
 namespace dcc::rx {
 
@@ -44,9 +63,32 @@ using namespace bidi;
 
 /// CRTP base for receiving DCC
 ///
-/// \tparam T Type to downcast to
-template<typename T>
+/// \tparam T   Type to downcast to
+/// \tparam Cfg Configuration
+template<typename T, Config Cfg = Config{}>
 struct CrtpBase {
+  static_assert(Cfg.inputs > 0uz && Cfg.inputs <= 32uz,
+                "Number of inputs must be within 1 and 32");
+  static_assert(Cfg.glitch_filter <= Cfg.timing_windows.bit1_min,
+                "Glitch filter would swallow valid bits");
+  static_assert(!(Cfg.handler_mode &
+                  ~instruction_mask<Instruction::AdvancedOperations,
+                                    Instruction::SpeedDirection,
+                                    Instruction::FunctionGroup,
+                                    Instruction::FeatureExpansion>),
+                "Instruction can't be executed in handler mode");
+  static_assert(!Cfg.smp || (!Cfg.histogram && !Cfg.statistics &&
+                             !Cfg.address_filter && !Cfg.coalesce &&
+                             !Cfg.priority_estop && !Cfg.handler_mode &&
+                             Cfg.overflow == Overflow::DropNewest),
+                "Histogram, statistics, address filter, coalescing, priority "
+                "slot, handler mode and overflow policies other than dropping "
+                "the newest packet require a single core");
+  static_assert(!Cfg.compact_deque ||
+                  (!Cfg.coalesce && Cfg.overflow == Overflow::DropNewest),
+                "Compact deque can't be combined with coalescing or overflow "
+                "policies other than dropping the newest packet");
+
   friend T;
 
   /// Initialize
@@ -83,31 +125,39 @@ struct CrtpBase {
     // BiDi
     auto const bidi_enabled{static_cast<bool>(cv29 & ztl::mask<3u>)};
     auto const ch2_consist_enabled{static_cast<bool>(cv20 & ztl::mask<7u>)};
-    auto const cv28{impl().readCv(28u - 1u)};
-    _ch1_addr_enabled = bidi_enabled && (cv28 & ztl::mask<0u>);
-    _ch2_data_enabled = bidi_enabled && (cv28 & ztl::mask<1u>);
-    _logon_enabled = bidi_enabled && (cv28 & ztl::mask<7u>);
-    _ch2_consist_enabled = bidi_enabled && ch2_consist_enabled;
-    if constexpr (HighCurrent<T>) impl().highCurrentBiDi(cv28 & ztl::mask<6u>);
-
-    // IDs
-    _did = {impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 0u),
-            impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 1u),
-            impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 2u),
-            impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 3u)};
-    _cids.front() = static_cast<decltype(_cids)::value_type>(
-      (impl().readCv(DCC_RX_LOGON_CID_CV_ADDRESS + 0u) << 8u) |
-      impl().readCv(DCC_RX_LOGON_CID_CV_ADDRESS + 1u));
-    _sids.front() = impl().readCv(DCC_RX_LOGON_SID_CV_ADDRESS);
-
-    // Logon address
-    std::array const logon_addr_cvs{
-      impl().readCv(DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 0u),
-      impl().readCv(DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 1u)};
-    _addrs.logon = decode_address(logon_addr_cvs);
+    if constexpr (features.bidi) {
+      auto const cv28{impl().readCv(28u - 1u)};
+      _ch1_addr_enabled = bidi_enabled && (cv28 & ztl::mask<0u>);
+      _ch2_data_enabled = bidi_enabled && (cv28 & ztl::mask<1u>);
+      _ch2_consist_enabled = bidi_enabled && ch2_consist_enabled;
+      if constexpr (features.logon)
+        _cold.logon.enabled = bidi_enabled && (cv28 & ztl::mask<7u>);
+      if constexpr (HighCurrent<T>)
+        impl().highCurrentBiDi(cv28 & ztl::mask<6u>);
+    }
+
+    if constexpr (features.logon) {
+      // IDs
+      _cold.logon.did = {impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 0u),
+                         impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 1u),
+                         impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 2u),
+                         impl().readCv(DCC_RX_LOGON_DID_CV_ADDRESS + 3u)};
+      _cold.logon.cids.front() =
+        static_cast<decltype(_cold.logon.cids)::value_type>(
+          (impl().readCv(DCC_RX_LOGON_CID_CV_ADDRESS + 0u) << 8u) |
+          impl().readCv(DCC_RX_LOGON_CID_CV_ADDRESS + 1u));
+      _cold.logon.sids.front() = impl().readCv(DCC_RX_LOGON_SID_CV_ADDRESS);
+
+      // Logon address
+      std::array const logon_addr_cvs{
+        impl().readCv(DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 0u),
+        impl().readCv(DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 1u)};
+      _addrs.logon = decode_address(logon_addr_cvs);
+    }
 
     // Initialization time point
-    _tps.init = std::chrono::system_clock::now();
+    if constexpr (features.tip_off)
+      _cold.tos.tps.init = std::chrono::system_clock::now();
   }
 
   /// Enable
@@ -125,76 +175,235 @@ struct CrtpBase {
 
   /// Encoding of commands bit by bit
   ///
+  /// A time within TCS right after a packet end is recognized as cutout start
+  /// and the receiver stays at packet end. If implemented, cutoutStart gets
+  /// called with the offsets (relative to the current edge) at which channel
+  /// 1 and 2 must start.
+  ///
+  /// Once a queued packet can be executed, packetQueued gets called if
+  /// implemented.
+  ///
   /// \param  time  Time in µs
-  void receive(uint32_t time) {
-    _packet_end = false; // Whatever we got, its not packet end anymore
+  /// \param  i     Input
+  void receive(uint32_t time, size_t i = 0uz) {
+    if constexpr (Cfg.histogram) _histograms[_histogram].add(time);
 
-    auto const bit{time2bit(time)};
-    if (bit == Invalid) return reset();
+    auto& in{_inputs[i]};
 
-    // Alternate halfbit <-> bit
-    if (_state > Startbit && (_is_halfbit = !_is_halfbit)) return;
+    // Cutout start right after packet end
+    if (_packet_end.load(std::memory_order_relaxed) && lastInput(in) &&
+        !in.glitch && time >= bidi::TCSMin && time <= bidi::TCSMax) {
+      if constexpr (Cutout<T>)
+        impl().cutoutStart(bidi::TTS1 - time, bidi::TTS2 - time);
+      return;
+    }
 
-    if (full(_deque)) return reset(); /// \todo task full error counter?
+    // Merge glitches into the following time
+    if constexpr (Cfg.glitch_filter) {
+      time += std::exchange(in.glitch, 0u);
+      if (time < Cfg.glitch_filter) {
+        in.glitch = time;
+        return;
+      }
+    }
+
+    // Whatever we got, its not packet end anymore
+    auto const packet_end{lastInput(in) && leavePacketEnd()};
+
+    auto const bit{classify(in, time)};
+    if (bit == Invalid) {
+      count(&Statistics::invalid_timings);
+      return reset(in);
+    }
+
+    // Alternate halfbit <-> bit
+    if (in.state > Startbit && (in.is_halfbit = !in.is_halfbit)) return;
 
     // Successfully received a bit
-    switch (_state) {
+    switch (in.state) {
       case Preamble:
-        if (bit) ++_bit_count;
-        else if (_bit_count < DCC_RX_MIN_PREAMBLE_BITS * 2uz) return reset();
-        else _state = Startbit;
+        if (bit) ++in.bit_count;
+        else if (in.bit_count < DCC_RX_MIN_PREAMBLE_BITS * 2uz) {
+          // Edge which ends packet end or cutout isn't a preamble
+          if (!packet_end) count(&Statistics::preamble_aborts);
+          return reset(in);
+        }
+        else in.state = Startbit;
         break;
 
       case Startbit:
-        _packet.clear();
-        _bit_count = 0uz;
-        _is_halfbit = false;
-        ++_preamble_count;
-        _state = Data;
+        buffer(in).clear();
+        in.bit_count = 0uz;
+        in.is_halfbit = false;
+        if (std::exchange(in.pending, true)) _qos.update(true);
+        in.state = Data;
         break;
 
       case Data:
-        _byte = static_cast<uint8_t>((_byte << 1u) | bit);
-        if (++_bit_count < CHAR_BIT) return;
-        _packet.push_back(_byte);
-        _checksum = static_cast<uint8_t>(_checksum ^ _byte);
-        _bit_count = _byte = 0u;
-        _state = Endbit;
+        in.byte = static_cast<uint8_t>((in.byte << 1u) | bit);
+        if (++in.bit_count < CHAR_BIT) return;
+        buffer(in).push_back(in.byte);
+        in.checksum = static_cast<uint8_t>(in.checksum ^ in.byte);
+        in.bit_count = in.byte = 0u;
+        in.state = Endbit;
         break;
 
       case Endbit:
+        // Byte wasn't the checksum, so it's part of the CRC
         if (!bit) {
-          _state = Data;
+          in.crc = crc8(static_cast<uint8_t>(in.crc ^ buffer(in).back()));
+          in.state = Data;
           return;
         }
-        // Execute or push back valid packet
-        else if (!_checksum && size(_packet) >= 3uz) {
-          _packet_end = true;
-          ++_packet_count;
-          _addrs.received = decode_address(_packet);
-          _instr = decode_instruction(_packet);
-          if (!executeHandlerMode()) _deque.push_back(_packet);
-        }
-        // Immediately clear received address and invalid packet
-        else {
-          _addrs.received = {};
-          _packet.clear();
-        }
-        reset();
+        endOfPacket(in);
+    }
+  }
+
+  /// Encoding of commands block by block
+  ///
+  /// Decodes a whole block of times (e.g. a DMA capture buffer) at once. The
+  /// result is identical to calling \ref receive for each time separately.
+  ///
+  /// \param  times Times in µs
+  /// \param  i     Input
+  void receive(std::span<uint32_t const> times, size_t i = 0uz) {
+    for (auto const time : times) receive(time, i);
+  }
+
+  /// Encoding of commands from packed bits
+  ///
+  /// Takes whole bits (not halfbits) packed MSB first into words, e.g. as
+  /// delivered by a SPI peripheral or FPGA which samples the track. The
+  /// preamble is skipped with count-leading-ones and bytes are extracted in
+  /// 9 bit groups (data byte and end bit) from a 64 bit accumulator. Bits
+  /// which don't complete a group are kept until the next call.
+  ///
+  /// \warning
+  /// Don't mix with \ref receive or \ref receiveTimestamp on the same input.
+  ///
+  /// \param  words Packed bits
+  /// \param  i     Input
+  void receiveBits(std::span<uint32_t const> words, size_t i = 0uz) {
+    auto& in{_inputs[i]};
+    for (auto const word : words) {
+      in.bits |= static_cast<uint64_t>(word) << (32u - in.bits_count);
+      in.bits_count += 32u;
+      while (in.state == Preamble ? in.bits_count : in.bits_count >= 9u) {
+        if (lastInput(in)) leavePacketEnd();
+        in.state == Preamble ? receivePreambleBits(in) : receiveDataBits(in);
+      }
     }
   }
 
+  /// Encoding of commands bit by bit from timestamps
+  ///
+  /// Instead of the time between two edges this takes the raw timestamp of a
+  /// free-running counter (e.g. a capture/compare register). The previous
+  /// timestamp is kept internally and counter wraparounds are taken care of.
+  ///
+  /// \tparam Bits      Counter width
+  /// \param  timestamp Timestamp in µs
+  /// \param  i         Input
+  template<size_t Bits = 32uz>
+  requires(Bits > 0uz && Bits <= 32uz)
+  void receiveTimestamp(uint32_t timestamp, size_t i = 0uz) {
+    constexpr auto mask{static_cast<uint32_t>((1ull << Bits) - 1ull)};
+    auto& in{_inputs[i]};
+    auto const time{(timestamp - in.timestamp) & mask};
+    in.timestamp = timestamp;
+    receive(time, i);
+  }
+
+  /// Encoding of commands block by block from 16 bit timestamps
+  ///
+  /// \tparam Bits        Counter width
+  /// \param  timestamps  Timestamps in µs
+  /// \param  i           Input
+  template<size_t Bits = 16uz>
+  requires(Bits > 0uz && Bits <= 16uz)
+  void receiveTimestamp(std::span<uint16_t const> timestamps, size_t i = 0uz) {
+    for (auto const timestamp : timestamps)
+      receiveTimestamp<Bits>(timestamp, i);
+  }
+
+  /// Encoding of commands block by block from 32 bit timestamps
+  ///
+  /// \tparam Bits        Counter width
+  /// \param  timestamps  Timestamps in µs
+  /// \param  i           Input
+  template<size_t Bits = 32uz>
+  requires(Bits > 0uz && Bits <= 32uz)
+  void receiveTimestamp(std::span<uint32_t const> timestamps, size_t i = 0uz) {
+    for (auto const timestamp : timestamps)
+      receiveTimestamp<Bits>(timestamp, i);
+  }
+
   /// Execute received commands
   ///
   /// \retval true  Command accepted
   /// \retval false Command rejected
   bool execute() { return executeThreadMode(); }
 
+  /// Execute up to n received commands
+  ///
+  /// \param  n Maximum number of commands
+  /// \return Number of commands handled (accepted or not)
+  size_t execute(size_t n) {
+    return execute([&n] { return n && n--; });
+  }
+
+  /// Execute received commands as long as budget allows
+  ///
+  /// The budget gets checked before each command, e.g. to compare a cycle
+  /// counter against a deadline.
+  ///
+  /// \tparam Budget  std::predicate
+  /// \param  budget  Budget left
+  /// \return Number of commands handled (accepted or not)
+  template<std::predicate Budget>
+  size_t execute(Budget budget) {
+    auto retval{0uz};
+    for (; pending() && budget(); ++retval) executeThreadMode();
+    // Packets which bypassed the deque still count as received
+    if constexpr (Cfg.address_filter || Cfg.handler_mode)
+      if (!packetEnd() && empty(_deque) && std::exchange(_bypassed, false))
+        prologue();
+    return retval;
+  }
+
+  /// Snapshot and reset histogram of received half bit timings
+  ///
+  /// Switches the histogram which gets recorded in handler mode, so this is
+  /// safe to call from thread mode.
+  ///
+  /// \return Histogram recorded since last call
+  Histogram histogram()
+  requires(Cfg.histogram)
+  {
+    auto& histogram{_histograms[_histogram]};
+    _histogram = !_histogram;
+    auto const retval{histogram};
+    histogram.clear();
+    return retval;
+  }
+
+  /// Receive statistics
+  ///
+  /// \return Statistics
+  Statistics statistics() const
+  requires(Cfg.statistics)
+  {
+    return _statistics;
+  }
+
   /// Service mode
   ///
   /// \retval true  Service mode active
   /// \retval false Operations mode active
-  bool serviceMode() const { return _mode == Service; }
+  bool serviceMode() const {
+    if constexpr (features.service_mode) return _mode == Service;
+    else return false;
+  }
 
   /// MAN function
   ///
@@ -206,76 +415,657 @@ struct CrtpBase {
   ///
   /// \retval true  Last received bit was packet end
   /// \retval false Last received bit wasn't packet end
-  bool packetEnd() const { return _packet_end; }
+  bool packetEnd() const { return detail::load<Cfg.smp>(_packet_end); }
 
   /// Addresses
   ///
   /// \return Addresses
   Addresses const& addresses() const { return _addrs; }
 
+  /// Layout of state accessed in handler mode
+  struct Layout {
+    size_t hot_first{};  ///< Offset of first hot byte
+    size_t hot_last{};   ///< Offset of one past last hot byte
+    size_t cold_first{}; ///< Offset of first cold byte
+  };
+
+  /// Layout of state accessed in handler mode
+  ///
+  /// \return Layout
+  static constexpr Layout layout() {
+    static_assert(std::is_standard_layout_v<CrtpBase>);
+    return {.hot_first = offsetof(CrtpBase, _inputs),
+            .hot_last = offsetof(CrtpBase, _addrs) + sizeof(Addresses),
+            .cold_first = offsetof(CrtpBase, _cold)};
+  }
+
   /// Add dyn (ID7) datagrams to deque
   ///
   /// \tparam Dyns... Types of dyn datagrams
   /// \param  dyns... Datagrams
   template<std::derived_from<app::Dyn>... Dyns>
-  void datagram(Dyns&&... dyns) {
-    // Block full and release empty deque to avoid getting the same datagrams
-    // send over and over again...
-    if (full(_dyn_deque)) _block_dyn_deque = true;
-    else if (empty(_dyn_deque)) {
-      _block_dyn_deque = false;
-      dyn(_qos, 7u);
-    }
+  void datagram([[maybe_unused]] Dyns&&... dyns) {
+    if constexpr (features.dyn) {
+      // Block full and release empty deque to avoid getting the same
+      // datagrams send over and over again...
+      if (full(_dyn_deque)) _block_dyn_deque = true;
+      else if (empty(_dyn_deque)) {
+        _block_dyn_deque = false;
+        dyn(_qos, 7u);
+      }
 
-    // Only allow pushing datagrams if not blocked
-    if (!_block_dyn_deque) (dyn(dyns.d, dyns.x), ...);
+      // Only allow pushing datagrams if not blocked
+      if (!_block_dyn_deque) (dyn(dyns.d, dyns.x), ...);
+    }
   }
 
   /// Start channel1 (12 bit payload)
   void biDiChannel1() {
-    if (!packetEnd()) return;
-    switch (_addrs.received.type) {
-      case Address::BasicLoco: [[fallthrough]];
-      case Address::ExtendedLoco: appAdr(); break;
-      case Address::AutomaticLogon: appLogon(1u); break;
-      default: break;
+    if constexpr (features.bidi) {
+      if (!packetEnd()) return;
+      switch (_addrs.received.type) {
+        case Address::BasicLoco: [[fallthrough]];
+        case Address::ExtendedLoco: appAdr(); break;
+        case Address::AutomaticLogon:
+          if constexpr (features.logon) appLogon(1u);
+          break;
+        default: break;
+      }
     }
   }
 
   /// Start channel2 (36 bit payload)
   void biDiChannel2() {
-    if (!packetEnd()) return;
-    switch (_addrs.received.type) {
-      case Address::Broadcast: appTos(); break;
-      case Address::BasicLoco: [[fallthrough]];
-      case Address::ExtendedLoco:
-        if (_addrs.received ==
-            (_logon_assigned ? _addrs.logon : _addrs.primary))
-          !empty(_pom.deque) || _instr == Instruction::CvLong ? appPom()
-                                                              : appDyn();
-        else if (_addrs.received == _addrs.consist && _ch2_consist_enabled)
-          appDyn();
-        break;
-      case Address::AutomaticLogon: appLogon(2u); break;
-      default: break;
+    if constexpr (features.bidi) {
+      if (!packetEnd()) return;
+      switch (_addrs.received.type) {
+        case Address::Broadcast:
+          if constexpr (features.tip_off) appTos();
+          break;
+        case Address::BasicLoco: [[fallthrough]];
+        case Address::ExtendedLoco:
+          if (_addrs.received ==
+              (logonAssigned() ? _addrs.logon : _addrs.primary))
+            appPomOrDyn();
+          else if (_addrs.received == _addrs.consist && _ch2_consist_enabled)
+            appDyn();
+          break;
+        case Address::AutomaticLogon:
+          if constexpr (features.logon) appLogon(2u);
+          break;
+        default: break;
+      }
     }
   }
 
 private:
-  constexpr CrtpBase() = default;
+  enum State : uint8_t { Preamble, Startbit, Data, Endbit };
+  enum Mode : uint8_t { Operations, Service };
+
+  /// Features compiled in, BiDi datagrams are removed along with BiDi
+  static constexpr Features features{
+    .bidi = Cfg.features.bidi,
+    .logon = Cfg.features.bidi && Cfg.features.logon,
+    .tip_off = Cfg.features.bidi && Cfg.features.tip_off,
+    .dyn = Cfg.features.bidi && Cfg.features.dyn,
+    .pom = Cfg.features.pom,
+    .service_mode = Cfg.features.service_mode};
+
+  constexpr CrtpBase() {
+    constexpr auto l{layout()};
+    static_assert(!l.hot_first && l.hot_last <= l.cold_first,
+                  "Hot state must start the decoder and precede cold state");
+    // Without optional hot state a single input fits a 64 byte line
+    static_assert(sizeof(void*) != 4uz || Cfg.inputs > 1uz || Cfg.statistics ||
+                    Cfg.address_filter || Cfg.priority_estop ||
+                    Cfg.handler_mode || l.hot_last <= 64uz,
+                  "Hot state of single input decoder exceeds 64 bytes");
+  }
   Decoder auto& impl() { return static_cast<T&>(*this); }
   Decoder auto const& impl() const { return static_cast<T const&>(*this); }
 
+  /// Bit level state of a single input
+  struct Input {
+    [[no_unique_address]] std::
+      conditional_t<(Cfg.inputs > 1uz), Packet, std::monostate> packet{};
+    [[no_unique_address]] std::conditional_t<
+      static_cast<bool>(Cfg.adaptive_timing),
+      TimingTracker<Cfg.timing_windows, Cfg.adaptive_timing>,
+      std::monostate> timing_tracker{};
+    uint64_t bits{};       ///< Packed bits accumulator (MSB first)
+    uint32_t bits_count{}; ///< Number of bits in accumulator
+    uint32_t timestamp{};  ///< Last timestamp
+    uint32_t glitch{};     ///< Time of glitches merged so far
+    size_t bit_count{};
+    uint8_t byte{};
+    uint8_t checksum{}; ///< On-the-fly calculated checksum
+    uint8_t crc{};      ///< On-the-fly calculated CRC8 (without checksum)
+    State state{};
+    bool is_halfbit{};
+    bool pending{}; ///< Packet of last preamble pending
+  };
+
+  /// Packet with coalesced repetitions
+  struct Repeated : Packet {
+    uint8_t repetitions{}; ///< Repetitions still to execute
+  };
+
+  /// De-duplication of packets received on multiple inputs
+  struct Dedup {
+    Packet packet{};   ///< Last accepted packet
+    uint32_t inputs{}; ///< Inputs which delivered the last accepted packet
+    uint8_t input{};   ///< Input of the last accepted packet
+  };
+
+  /// Classify time
+  ///
+  /// If adaptive timing is enabled, the preamble and startbit are classified
+  /// against the standard windows and used to learn the bit timings. All
+  /// following bits are classified against the learned windows.
+  ///
+  /// \param  in    Input
+  /// \param  time  Time in µs
+  /// \return Bit
+  Bit classify(Input& in, uint32_t time) {
+    if constexpr (Cfg.adaptive_timing) {
+      if (in.state > Startbit) return in.timing_tracker.time2bit(time);
+      auto const bit{time2bit<Cfg.timing_windows>(time)};
+      if (bit == _1) in.timing_tracker.bit1(time);
+      else if (bit == _0) in.timing_tracker.bit0(time);
+      return bit;
+    } else return time2bit<Cfg.timing_windows>(time);
+  }
+
+  /// Consume preamble and startbit from packed bits
+  ///
+  /// \param  in  Input
+  void receivePreambleBits(Input& in) {
+    auto const ones{std::min(static_cast<uint32_t>(std::countl_one(in.bits)),
+                             in.bits_count)};
+    in.bit_count += ones;
+
+    // Whole accumulator is preamble
+    if (ones == in.bits_count) return consumeBits(in, ones);
+
+    // Startbit
+    consumeBits(in, ones + 1u);
+    if (in.bit_count < DCC_RX_MIN_PREAMBLE_BITS) {
+      count(&Statistics::preamble_aborts);
+      return reset(in);
+    }
+    buffer(in).clear();
+    in.bit_count = 0uz;
+    if (std::exchange(in.pending, true)) _qos.update(true);
+    in.state = Data;
+  }
+
+  /// Consume complete 9 bit groups from packed bits
+  ///
+  /// The end bits of all complete groups are masked at once, so the number of
+  /// data bytes up to the packet end is known in advance.
+  ///
+  /// \param  in  Input
+  void receiveDataBits(Input& in) {
+    constexpr auto end_bits{(1ull << 55u) | (1ull << 46u) | (1ull << 37u) |
+                            (1ull << 28u)};
+    auto const groups{in.bits_count / 9u};
+    auto const ends{in.bits & end_bits & ~(~0ull >> (groups * 9u))};
+    auto const bytes{ends ? (std::countl_zero(ends) - 8u) / 9u + 1u : groups};
+
+    auto& packet{buffer(in)};
+    for (auto i{0u}; i < bytes; ++i) {
+      if (full(packet)) return reset(in);
+      auto const byte{static_cast<uint8_t>(in.bits >> 56u)};
+      packet.push_back(byte);
+      in.checksum = static_cast<uint8_t>(in.checksum ^ byte);
+      if (!ends || i + 1u < bytes)
+        in.crc = crc8(static_cast<uint8_t>(in.crc ^ byte));
+      consumeBits(in, 9u);
+    }
+
+    if (ends) endOfPacket(in);
+  }
+
+  /// Consume packed bits
+  ///
+  /// \param  in    Input
+  /// \param  count Number of bits
+  void consumeBits(Input& in, uint32_t count) {
+    in.bits = count < 64u ? in.bits << count : 0ull;
+    in.bits_count -= count;
+  }
+
+  /// Check if commands are pending for thread mode
+  ///
+  /// \retval true  Commands pending
+  /// \retval false No commands pending or packet end
+  bool pending() const {
+    if (packetEnd()) return false;
+    if constexpr (Cfg.priority_estop)
+      if (_priority.pending) return true;
+    return !empty(_deque);
+  }
+
+  /// Leave packet end
+  ///
+  /// Thread mode can't execute anything at packet end. If implemented,
+  /// packetQueued gets called right after packet end to notify thread mode that
+  /// work is pending.
+  ///
+  /// \retval true  Packet end left
+  /// \retval false Not at packet end
+  bool leavePacketEnd() {
+    if (!_packet_end.load(std::memory_order_relaxed)) return false;
+    detail::store<Cfg.smp>(_packet_end, false);
+    if constexpr (PacketQueued<T>)
+      if (pending()) impl().packetQueued();
+    return true;
+  }
+
+  /// Packet buffer of input
+  ///
+  /// With a single input, packets are received directly into the next slot of
+  /// the deque.
+  ///
+  /// \param  in  Input
+  /// \return Packet buffer
+  Packet& buffer(Input& in) {
+    if constexpr (Cfg.inputs > 1uz) return in.packet;
+    else return _deque.next();
+  }
+
+  /// Execute or commit valid packet
+  ///
+  /// \param  in  Input
+  void endOfPacket(Input& in) {
+    auto& packet{buffer(in)};
+    if (!in.checksum && size(packet) >= 3uz) {
+      in.pending = false;
+      _qos.update(false);
+      if (duplicate(in)) return reset(in);
+      _packet = &packet;
+      detail::store<Cfg.smp>(_packet_end, true);
+      auto const header{decode_header(packet[0uz])};
+      _addrs.received = decode_address(header, cbegin(packet));
+      std::span<uint8_t const> const bytes{cbegin(packet) + header.size,
+                                           cend(packet)};
+      _instr = decode_instruction(bytes);
+      prioritize(bytes);
+      track(packet);
+      if (executeHandlerMode(bytes, in.crc))
+        ;
+      else if (filtered())
+        ;
+      else if (coalesced(packet)) count(&Statistics::packets_accepted);
+      else {
+        prepare(packet);
+        if (full(_deque)) overflow(packet);
+        else {
+          _deque.commit();
+          count(&Statistics::packets_accepted);
+        }
+      }
+    }
+    // Immediately clear received address and invalid packet
+    else {
+      if (in.checksum) count(&Statistics::checksum_errors);
+      _addrs.received = {};
+      packet.clear();
+      _packet = &packet;
+    }
+    reset(in);
+  }
+
+  /// Track state of thread mode in the order packets get received
+  ///
+  /// Thread mode might lag behind by the whole deque, so the address filter
+  /// and handler mode can't rely on its state. Service mode is tracked
+  /// separately and both get held as long as packets which thread mode has
+  /// to execute first are queued (see \ref holds).
+  ///
+  /// \param  packet  Packet
+  void track(Packet const& packet) {
+    if constexpr (Cfg.address_filter || Cfg.handler_mode) {
+      // Reset and service mode packets stay in service mode, anything else
+      // exits it
+      if (_filter.service) {
+        _filter.service =
+          !packet[0uz] || (packet[0uz] & 0xF0u) == 0b0111'0000u;
+        _filter.hold = size(_deque) + 1uz;
+        return;
+      }
+
+      switch (auto const addr{_addrs.received}; addr.type) {
+        // Reset packet enters service mode
+        case Address::Broadcast: _filter.service = !packet[1uz]; break;
+        case Address::BasicLoco: [[fallthrough]];
+        case Address::ExtendedLoco:
+          if (own(addr)) break;
+          return;
+        default: return;
+      }
+      if (holds(_instr)) _filter.hold = size(_deque) + 1uz;
+    }
+  }
+
+  /// Check if queued instruction holds address filter and handler mode
+  ///
+  /// Decoder control, consist control and CV access might change the own
+  /// addresses or the count of own equal packets. Instructions executed in
+  /// thread mode which share state with ones executed in handler mode (e.g.
+  /// 126 and 28 speed steps) must not get overtaken either.
+  ///
+  /// \param  instr Instruction
+  /// \retval true  Instruction holds
+  /// \retval false Instruction doesn't hold
+  static constexpr bool holds(Instruction instr) {
+    constexpr auto mask{[] {
+      auto retval{instruction_mask<Instruction::DecoderControl,
+                                   Instruction::ConsistControl,
+                                   Instruction::CvLong,
+                                   Instruction::CvShort>};
+      // Speed, direction and functions packets (0x3C) share state with all
+      if (Cfg.handler_mode & instruction_mask<Instruction::SpeedDirection,
+                                              Instruction::FunctionGroup,
+                                              Instruction::FeatureExpansion>)
+        retval |= instruction_mask<Instruction::AdvancedOperations>;
+      if (Cfg.handler_mode & instruction_mask<Instruction::AdvancedOperations>)
+        retval |= instruction_mask<Instruction::SpeedDirection,
+                                   Instruction::FunctionGroup,
+                                   Instruction::FeatureExpansion>;
+      return retval & ~Cfg.handler_mode;
+    }()};
+    return mask & (1u << std::to_underlying(instr));
+  }
+
+  /// Check if packet gets filtered
+  ///
+  /// Early address filter which mirrors the decisions of thread mode. As long
+  /// as service mode or packets which might change the own addresses are
+  /// tracked, nothing gets filtered.
+  ///
+  /// \retval true  Packet gets filtered
+  /// \retval false Packet is of interest
+  bool filtered() {
+    if constexpr (Cfg.address_filter) {
+      switch (auto const addr{_addrs.received}; addr.type) {
+        case Address::Broadcast: return false;
+        case Address::BasicLoco: [[fallthrough]];
+        case Address::ExtendedLoco:
+          if (own(addr)) return false;
+          break;
+        default: break;
+      }
+      if (_filter.service || _filter.hold) return false;
+      return _bypassed = true;
+    } else return false;
+  }
+
+  /// Check if address is own
+  ///
+  /// \param  addr  Address
+  /// \retval true  Address is primary or consist and logon ain't assigned, or
+  ///                address is logon and logon is assigned
+  /// \retval false Address is not of interest
+  bool own(Address addr) const {
+    return ((addr == _addrs.primary || addr == _addrs.consist) &&
+            !logonAssigned()) ||
+           (addr == _addrs.logon && logonAssigned());
+  }
+
+  /// Check if logon address is assigned
+  ///
+  /// \retval true  Logon address assigned
+  /// \retval false Logon address not assigned
+  bool logonAssigned() const {
+    if constexpr (features.logon) return _cold.logon.assigned;
+    else return false;
+  }
+
+  /// Put own or broadcast emergency stop into priority slot
+  ///
+  /// The packet itself still gets queued.
+  ///
+  /// \param  bytes Raw bytes following the address
+  void prioritize([[maybe_unused]] std::span<uint8_t const> bytes) {
+    if constexpr (Cfg.priority_estop) {
+      auto const addr{_addrs.received};
+      if (serviceMode() || handlerMode(_instr) ||
+          (addr.type != Address::Broadcast && addr.type != Address::BasicLoco &&
+           addr.type != Address::ExtendedLoco) ||
+          (addr && !own(addr)))
+        return;
+      auto const dir{estop(bytes)};
+      if (!dir) return;
+      // Logon address is treated as primary from here on
+      _priority.addr = addr == _addrs.logon && logonAssigned()
+                         ? _addrs.primary.value
+                         : addr.value;
+      _priority.dir = *dir;
+      _priority.stale = size(_deque);
+      _priority.pending = true;
+    }
+  }
+
+  /// Check if packet got coalesced with newest packet in the deque
+  ///
+  /// The first packet of the deque might currently get executed and is never
+  /// coalesced.
+  ///
+  /// \param  packet  Packet
+  /// \retval true    Packet got coalesced
+  /// \retval false   Packet needs a slot of its own
+  bool coalesced(Packet const& packet) {
+    if constexpr (Cfg.coalesce) {
+      if (size(_deque) < 2uz) return false;
+      auto& back{_deque.back()};
+      if (back.repetitions == std::numeric_limits<uint8_t>::max() ||
+          static_cast<Packet const&>(back) != packet)
+        return false;
+      ++back.repetitions;
+      return true;
+    } else return false;
+  }
+
+  /// Copy packet to next slot of the deque
+  ///
+  /// \param  packet  Packet
+  void prepare(Packet const& packet) {
+    if constexpr (Cfg.inputs > 1uz)
+      static_cast<Packet&>(_deque.next()) = packet;
+    if constexpr (Cfg.coalesce) _deque.next().repetitions = 0u;
+  }
+
+  /// Handle packet received while the deque is full
+  ///
+  /// The first packet of the deque might currently get executed and is never
+  /// dropped or replaced.
+  ///
+  /// \param  packet  Packet
+  void overflow(Packet const& packet) {
+    if constexpr (Cfg.overflow == Overflow::DropNewest)
+      count(&Statistics::deque_overflows);
+    else {
+      auto pos{replaceable(packet)};
+      if (pos) count(&Statistics::deque_replacements);
+      else {
+        pos = 1uz;
+        count(&Statistics::deque_drops);
+      }
+      if constexpr (Cfg.priority_estop)
+        if (pos < _priority.stale) --_priority.stale;
+      if constexpr (Cfg.address_filter || Cfg.handler_mode)
+        if (pos < _filter.hold) --_filter.hold;
+      _deque.replace(pos);
+      count(&Statistics::packets_accepted);
+    }
+  }
+
+  /// Find oldest packet in the deque which carries the same command
+  ///
+  /// \param  packet  Packet
+  /// \return Position of packet in the deque or 0 if there is none
+  size_t replaceable(Packet const& packet) {
+    if constexpr (Cfg.overflow == Overflow::Replace)
+      for (auto pos{1uz}; pos < size(_deque); ++pos)
+        if (sameCommand(_deque[pos], packet)) return pos;
+    return 0uz;
+  }
+
+  /// Check if packets carry the same command
+  ///
+  /// Commands are the same if they control the same state of the same address
+  /// (e.g. speed or F5-F8). Newer commands thus supersede older ones.
+  ///
+  /// \param  lhs Packet
+  /// \param  rhs Packet
+  /// \retval true  Packets carry same command
+  /// \retval false Packets carry different commands
+  static constexpr bool sameCommand(Packet const& lhs, Packet const& rhs) {
+    auto const lhs_header{decode_header(lhs[0uz])};
+    auto const rhs_header{decode_header(rhs[0uz])};
+    switch (lhs_header.type) {
+      case Address::Broadcast: [[fallthrough]];
+      case Address::BasicLoco: [[fallthrough]];
+      case Address::ExtendedLoco: break;
+      default: return false;
+    }
+    auto const instr{decode_instruction(lhs)};
+    if (decode_address(lhs) != decode_address(rhs) ||
+        instr != decode_instruction(rhs))
+      return false;
+    auto const l{lhs[lhs_header.size]};
+    auto const r{rhs[rhs_header.size]};
+    switch (instr) {
+      case Instruction::SpeedDirection: return true;
+      // F0-F4 carry state in 5 bits, F5-F8 and F9-F12 in 4 bits
+      case Instruction::FunctionGroup:
+        return (l & 0xE0u) == 0b1000'0000u ? (r & 0xE0u) == 0b1000'0000u
+                                           : (l & 0xF0u) == (r & 0xF0u);
+      // Everything but binary states
+      case Instruction::FeatureExpansion:
+        return l == r && l != 0b1100'0000u && l != 0b1101'1101u;
+      // Everything but analog function group
+      case Instruction::AdvancedOperations:
+        return l == r && l != 0b0011'1101u;
+      default: return false;
+    }
+  }
+
+  /// Increment statistics counter
+  ///
+  /// \param  counter Counter
+  void count(uint32_t Statistics::*counter) {
+    if constexpr (Cfg.statistics) ++(_statistics.*counter);
+  }
+
+  /// Check if packet was already received on another input
+  ///
+  /// Packets are only considered duplicates if they equal the last accepted
+  /// one and their input hasn't delivered that one yet. Repetitions on the
+  /// same input (e.g. for CV access) therefore still pass.
+  ///
+  /// \param  in    Input
+  /// \retval true  Packet is a duplicate
+  /// \retval false Packet is new
+  bool duplicate(Input const& in) {
+    if constexpr (Cfg.inputs > 1uz) {
+      auto const i{static_cast<uint8_t>(&in - data(_inputs))};
+      auto const mask{1u << i};
+      if (!(_dedup.inputs & mask) && in.packet == _dedup.packet) {
+        _dedup.inputs |= mask;
+        return true;
+      }
+      _dedup.packet = in.packet;
+      _dedup.inputs = mask;
+      _dedup.input = i;
+    }
+    return false;
+  }
+
+  /// Check if input delivered the last accepted packet
+  ///
+  /// \param  in    Input
+  /// \retval true  Input delivered the last accepted packet
+  /// \retval false Input didn't deliver the last accepted packet
+  bool lastInput(Input const& in) const {
+    if constexpr (Cfg.inputs > 1uz) return &in == &_inputs[_dedup.input];
+    else return true;
+  }
+
+  /// Last received packet
+  ///
+  /// \return Last received packet
+  Packet const& packet() const { return *_packet; }
+
   /// Execute in handler mode (interrupt context)
   ///
+  /// \param  bytes Raw bytes following the address
+  /// \param  crc   CRC8 of packet calculated on-the-fly
   /// \retval true  Command accepted
   /// \retval false Command rejected
-  bool executeHandlerMode() {
-    if (_addrs.received.type == Address::AutomaticLogon &&
-        (size(_packet) <= (6uz + sizeof(_checksum)) || !crc8(_packet)))
-      return executeAutomaticLogon(_addrs.received,
-                                   {cbegin(_packet) + 1, cend(_packet)});
-    else return false;
+  bool executeHandlerMode(std::span<uint8_t const> bytes,
+                          [[maybe_unused]] uint8_t crc) {
+    if constexpr (features.logon)
+      if (_addrs.received.type == Address::AutomaticLogon &&
+          (size(bytes) <= (5uz + sizeof(Input::checksum)) || !crc))
+        return executeAutomaticLogon(_addrs.received, bytes);
+    return executeOperationsHandlerMode(bytes);
+  }
+
+  /// Check if instruction gets executed in handler mode
+  ///
+  /// \param  instr Instruction
+  /// \retval true  Instruction gets executed in handler mode
+  /// \retval false Instruction gets executed in thread mode
+  static constexpr bool handlerMode(Instruction instr) {
+    return Cfg.handler_mode & (1u << std::to_underlying(instr));
+  }
+
+  /// Execute own and broadcast commands of Config::handler_mode
+  ///
+  /// Commands are left for thread mode as long as it hasn't caught up with
+  /// service mode or packets which hold (see \ref track).
+  ///
+  /// \param  bytes Raw bytes following the address
+  /// \retval true  Command executed
+  /// \retval false Command left for thread mode
+  bool executeOperationsHandlerMode(
+    [[maybe_unused]] std::span<uint8_t const> bytes) {
+    if constexpr (Cfg.handler_mode) {
+      if (!handlerMode(_instr) || serviceMode() || _filter.service ||
+          _filter.hold)
+        return false;
+      auto addr{_addrs.received};
+      switch (addr.type) {
+        case Address::Broadcast: [[fallthrough]];
+        case Address::BasicLoco: [[fallthrough]];
+        case Address::ExtendedLoco: break;
+        default: return false;
+      }
+      if (addr && !own(addr)) return false;
+      // Address is logon and logon assigned, pretend it's primary from here on
+      if (addr == _addrs.logon && logonAssigned()) addr = _addrs.primary;
+      switch (_instr) {
+        case Instruction::AdvancedOperations:
+          executeAdvancedOperations(addr, bytes);
+          break;
+        case Instruction::SpeedDirection:
+          executeSpeedDirection(addr, bytes);
+          break;
+        case Instruction::FunctionGroup:
+          executeFunctionGroup(addr, bytes);
+          break;
+        case Instruction::FeatureExpansion:
+          executeFeatureExpansion(addr, bytes);
+          break;
+        default: break;
+      }
+      // Own packet in between CV access packets
+      _own_equal_packets_count = 0uz;
+      _bypassed = true;
+      return true;
+    } else return false;
   }
 
   /// Execute in thread mode
@@ -283,30 +1073,114 @@ private:
   /// \retval true  Command accepted
   /// \retval false Command rejected
   bool executeThreadMode() {
-    if (packetEnd() || empty(_deque)) return false;
-    adr();              // Prepare address broadcasts for BiDi channel 1
-    logonStore();       // Store logon information if necessary
-    updateQos();        // Update quality of service
-    updateTimePoints(); // Update time points for tip-off search
+    if (packetEnd()) return false;
+    else if (executePriority()) return true;
+    else if (empty(_deque)) {
+      // Packets which bypassed the deque still count as received
+      if constexpr (Cfg.address_filter || Cfg.handler_mode)
+        if (std::exchange(_bypassed, false)) prologue();
+      return false;
+    }
+    prologue();
     auto const retval{serviceMode() ? executeService() : executeOperations()};
+    if constexpr (Cfg.coalesce)
+      if (_deque.front().repetitions) {
+        --_deque.front().repetitions;
+        count(&Statistics::packets_executed);
+        return retval;
+      }
+    if constexpr (Cfg.priority_estop)
+      if (_priority.stale) --_priority.stale;
+    if constexpr (Cfg.address_filter || Cfg.handler_mode)
+      if (_filter.hold) --_filter.hold;
     _deque.pop_front();
+    count(&Statistics::packets_executed);
     return retval;
   }
 
+  /// Execute emergency stop of priority slot
+  ///
+  /// \retval true  Emergency stop executed
+  /// \retval false Priority slot empty
+  bool executePriority() {
+    if constexpr (Cfg.priority_estop) {
+      if (!std::exchange(_priority.pending, false) || serviceMode())
+        return false;
+      directionSpeed(_priority.addr, _priority.dir, EStop);
+      return true;
+    } else return false;
+  }
+
+  /// Check if speed of first packet of the deque is outdated by an emergency
+  /// stop
+  ///
+  /// Speed packets which got queued before a prioritized emergency stop of the
+  /// same address, or a broadcast one, must not restart the motor.
+  ///
+  /// \param  addr  Address
+  /// \param  bytes Raw bytes
+  /// \retval true  Speed is outdated
+  /// \retval false Speed is not outdated
+  bool outdated([[maybe_unused]] Address::value_type addr,
+                [[maybe_unused]] std::span<uint8_t const> bytes) const {
+    if constexpr (Cfg.priority_estop)
+      return _priority.stale &&
+             (!_priority.addr || !addr || addr == _priority.addr) &&
+             speedInstruction(bytes);
+    else return false;
+  }
+
+  /// Check if instruction contains speed
+  ///
+  /// \param  bytes Raw bytes
+  /// \retval true  Instruction contains speed
+  /// \retval false Instruction doesn't contain speed
+  static constexpr bool speedInstruction(std::span<uint8_t const> bytes) {
+    return decode_instruction(bytes) == Instruction::SpeedDirection ||
+           bytes[0uz] == 0b0011'1111u || bytes[0uz] == 0b0011'1100u;
+  }
+
+  /// Decode emergency stop
+  ///
+  /// \param  bytes Raw bytes
+  /// \return Direction of emergency stop or std::nullopt
+  static constexpr std::optional<bool> estop(std::span<uint8_t const> bytes) {
+    if (!speedInstruction(bytes)) return std::nullopt;
+    // 14 or 28 speed steps
+    else if (decode_instruction(bytes) == Instruction::SpeedDirection) {
+      if (size(bytes) == 1uz + sizeof(Input::checksum) &&
+          (bytes[0uz] & 0b0000'1111u) == 1u)
+        return static_cast<bool>(bytes[0uz] & ztl::mask<5u>);
+    }
+    // 126 speed steps
+    else if (size(bytes) >= 2uz + sizeof(Input::checksum) &&
+             (bytes[1uz] & 0b0111'1111u) == 1u)
+      return static_cast<bool>(bytes[1uz] & ztl::mask<7u>);
+    return std::nullopt;
+  }
+
+  /// Common to all received packets in thread mode
+  void prologue() {
+    // Prepare address broadcasts for BiDi channel 1
+    if constexpr (features.bidi) adr();
+    // Store logon information if necessary
+    if constexpr (features.logon) logonStore();
+    // Update time points for tip-off search
+    if constexpr (features.tip_off) updateTimePoints();
+  }
+
   /// Execute commands in operations mode
   ///
   /// \retval true  Command accepted
   /// \retval false Command rejected
   bool executeOperations() {
     auto const& packet{_deque.front()};
-    switch (auto const addr{decode_address(packet)}; addr.type) {
+    switch (auto const header{decode_header(packet[0uz])}; header.type) {
       case Address::Broadcast: [[fallthrough]];
-      case Address::BasicLoco:
-        return executeOperationsAddressed(addr,
-                                          {cbegin(packet) + 1, cend(packet)});
+      case Address::BasicLoco: [[fallthrough]];
       case Address::ExtendedLoco:
-        return executeOperationsAddressed(addr,
-                                          {cbegin(packet) + 2, cend(packet)});
+        return executeOperationsAddressed(
+          decode_address(packet), {cbegin(packet) + header.size, cend(packet)});
       default: return false;
     }
   }
@@ -345,19 +1219,29 @@ private:
       ;
     // Address is primary or consist and logon ain't assigned
     else if ((addr == _addrs.primary || addr == _addrs.consist) &&
-             !_logon_assigned)
+             !logonAssigned())
       ;
     // Address is logon and logon assigned, pretend it's primary from here on
-    else if (addr == _addrs.logon && _logon_assigned) addr = _addrs.primary;
+    else if (addr == _addrs.logon && logonAssigned())
+      addr = _addrs.primary;
     // Address is not of interest
     else return false;
 
     // Count own equal packets (required for CV access)
     countOwnEqualPackets();
 
+    // Skip speed but keep functions of speed, direction and function packets
+    if (outdated(addr, bytes)) {
+      if (bytes[0uz] != 0b0011'1100u ||
+          size(bytes) < 3uz + sizeof(Input::checksum))
+        return false;
+      executeFunctionsF0F31(addr, bytes);
+      return true;
+    }
+
     switch (decode_instruction(bytes)) {
       case Instruction::DecoderControl:
-        if (!addr && !bytes[0uz]) {
+        if (features.service_mode && !addr && !bytes[0uz]) {
           serviceMode(true);
           return true;
         } else return executeDecoderControl(bytes);
@@ -369,8 +1253,12 @@ private:
       case Instruction::FunctionGroup: return executeFunctionGroup(addr, bytes);
       case Instruction::FeatureExpansion:
         return executeFeatureExpansion(addr, bytes);
-      case Instruction::CvLong: return executeCvLong(addr, bytes);
-      case Instruction::CvShort: return executeCvShort(addr, bytes);
+      case Instruction::CvLong:
+        if constexpr (features.pom) return executeCvLong(addr, bytes);
+        else return false;
+      case Instruction::CvShort:
+        if constexpr (features.pom) return executeCvShort(addr, bytes);
+        else return false;
       default: return false;
     }
   }
@@ -382,7 +1270,7 @@ private:
   /// \retval true  Command accepted
   /// \retval false Command rejected
   bool executeAutomaticLogon(Address addr, std::span<uint8_t const> bytes) {
-    if (!_logon_enabled || addr != 254u) return false;
+    if (!_cold.logon.enabled || addr != 254u) return false;
 
     switch (bytes[0uz] & 0xF0u) {
       // SELECT
@@ -441,7 +1329,7 @@ private:
   /// \retval true  Command accepted
   /// \retval false Command rejected
   bool executeConsistControl(std::span<uint8_t const> bytes) {
-    if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+    if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
 
     switch (bytes[0uz] & 0x0Fu) {
       case 0b0000'0010u: [[fallthrough]];
@@ -468,30 +1356,15 @@ private:
     switch (bytes[0uz]) {
       // Speed, direction and function
       case 0b0011'1100u:
-        if (size(bytes) < 3uz + sizeof(_checksum)) return false;
-        // F7-F0
-        if (size(bytes) > 3uz)
-          impl().function(
-            addr, 0xFFu << 0u, static_cast<uint32_t>(bytes[2uz] << 0u));
-        // F15-F8
-        if (size(bytes) > 4uz)
-          impl().function(
-            addr, 0xFFu << 8u, static_cast<uint32_t>(bytes[3uz] << 8u));
-        // F23-F16
-        if (size(bytes) > 5uz)
-          impl().function(
-            addr, 0xFFu << 16u, static_cast<uint32_t>(bytes[4uz] << 16u));
-        // F31-F24
-        if (size(bytes) > 6uz)
-          impl().function(
-            addr, 0xFFu << 0u, static_cast<uint32_t>(bytes[5uz] << 24u));
+        if (size(bytes) < 3uz + sizeof(Input::checksum)) return false;
+        executeFunctionsF0F31(addr, bytes);
         // Adjust length before fallthrough
-        bytes = bytes.subspan(0uz, 2uz + sizeof(_checksum));
+        bytes = bytes.subspan(0uz, 2uz + sizeof(Input::checksum));
         [[fallthrough]];
 
       // 126 speed steps (plus 0)
       case 0b0011'1111u: {
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         auto const dir{static_cast<bool>(bytes[1uz] & ztl::mask<7u>)};
         // Stop
         if (!(bytes[1uz] & 0b0111'1111u)) directionSpeed(addr, dir, Stop);
@@ -507,7 +1380,7 @@ private:
 
       // Special operating modes
       case 0b0011'1110u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         _man = bytes[1uz] & ztl::mask<7u>;
         if constexpr (EastWest<T>) {
           if (bytes[1uz] & ztl::mask<6u>) // East
@@ -528,6 +1401,30 @@ private:
     return true;
   }
 
+  /// Execute functions of speed, direction and function packet
+  ///
+  /// \param  addr  Address
+  /// \param  bytes Raw bytes
+  void executeFunctionsF0F31(Address::value_type addr,
+                             std::span<uint8_t const> bytes) {
+    // F7-F0
+    if (size(bytes) > 3uz)
+      impl().function(
+        addr, 0xFFu << 0u, static_cast<uint32_t>(bytes[2uz] << 0u));
+    // F15-F8
+    if (size(bytes) > 4uz)
+      impl().function(
+        addr, 0xFFu << 8u, static_cast<uint32_t>(bytes[3uz] << 8u));
+    // F23-F16
+    if (size(bytes) > 5uz)
+      impl().function(
+        addr, 0xFFu << 16u, static_cast<uint32_t>(bytes[4uz] << 16u));
+    // F31-F24
+    if (size(bytes) > 6uz)
+      impl().function(
+        addr, 0xFFu << 24u, static_cast<uint32_t>(bytes[5uz] << 24u));
+  }
+
   /// Execute speed and direction
   ///
   /// \param  addr  Address
@@ -536,7 +1433,7 @@ private:
   /// \retval false Command rejected
   bool executeSpeedDirection(Address::value_type addr,
                              std::span<uint8_t const> bytes) {
-    if (size(bytes) != 1uz + sizeof(_checksum)) return false;
+    if (size(bytes) != 1uz + sizeof(Input::checksum)) return false;
 
     auto const dir{static_cast<bool>(bytes[0uz] & ztl::mask<5u>)};
     int32_t speed{};
@@ -580,7 +1477,7 @@ private:
   /// \retval false Command rejected
   bool executeFunctionGroup(Address::value_type addr,
                             std::span<uint8_t const> bytes) {
-    if (size(bytes) != 1uz + sizeof(_checksum)) return false;
+    if (size(bytes) != 1uz + sizeof(Input::checksum)) return false;
 
     uint32_t mask{};
     uint32_t state{};
@@ -626,7 +1523,7 @@ private:
     switch (bytes[0uz]) {
       // Binary state control instruction long form (3 bytes)
       case 0b1100'0000u:
-        if (size(bytes) != 3uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 3uz + sizeof(Input::checksum)) return false;
         binaryState((static_cast<uint32_t>(bytes[2uz]) << 7u) |
                       (bytes[1uz] & 0b0111'1111u),
                     bytes[1uz] & ztl::mask<7u>);
@@ -634,31 +1531,31 @@ private:
 
       // Binary state control instruction short form (2 bytes)
       case 0b1101'1101u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         binaryState((bytes[1uz] & 0b0111'1111u), bytes[1uz] & ztl::mask<7u>);
         break;
 
       // Time (4 bytes)
       case 0b1100'0001u:
-        if (size(bytes) != 4uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 4uz + sizeof(Input::checksum)) return false;
         time(bytes);
         break;
 
       // System time (3 bytes)
       case 0b1100'0010u:
-        if (size(bytes) != 3uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 3uz + sizeof(Input::checksum)) return false;
         /// \todo
         break;
 
       // Command station properties (4 bytes)
       case 0b1100'0011u:
-        if (size(bytes) != 4uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 4uz + sizeof(Input::checksum)) return false;
         /// \todo
         break;
 
       // F20-F19-F18-F17-F16-F15-F14-F13
       case 0b1101'1110u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         impl().function(addr,
                         ztl::mask<20u, 19u, 18u, 17u, 16u, 15u, 14u, 13u>,
                         static_cast<uint32_t>(bytes[1uz] << 13u));
@@ -666,7 +1563,7 @@ private:
 
       // F28-F27-F26-F25-F24-F23-F22-F21
       case 0b1101'1111u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         impl().function(addr,
                         ztl::mask<28u, 27u, 26u, 25u, 24u, 23u, 22u, 21u>,
                         static_cast<uint32_t>(bytes[1uz] << 21u));
@@ -674,27 +1571,27 @@ private:
 
       // F36-F35-F34-F33-F32-F31-F30-F29
       case 0b1101'1000u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         break;
 
       // F44-F43-F42-F41-F40-F39-F38-F37
       case 0b1101'1001u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         break;
 
       // F52-F51-F50-F49-F48-F47-F46-F45
       case 0b1101'1010u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         break;
 
       // F60-F59-F58-F57-F56-F55-F54-F53
       case 0b1101'1011u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         break;
 
       // F68-F67-F66-F65-F64-F63-F62-F61 (>F63 not supported)
       case 0b1101'1100u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         break;
     }
 
@@ -709,15 +1606,16 @@ private:
   /// \retval true  Command accepted
   /// \retval false Command rejected
   bool executeCvLong(Address::value_type addr, std::span<uint8_t const> bytes) {
-    if ((size(bytes) != 3uz + sizeof(_checksum)) ||
+    if ((size(bytes) != 3uz + sizeof(Input::checksum)) ||
         (addr && addr == _addrs.consist))
       return false;
 
     // Store packet for app:pom
-    if (_pom.packet != _deque.front()) {
-      _pom.deque.clear();
-      _pom.packet = _deque.front();
-    }
+    if constexpr (features.bidi && features.pom)
+      if (_pom.packet != _deque.front()) {
+        _pom.deque.clear();
+        _pom.packet = _deque.front();
+      }
 
     switch (uint32_t const cv_addr{(bytes[0uz] & 0b11u) << 8u | bytes[1uz]};
             static_cast<uint32_t>(bytes[0uz]) >> 2u & 0b11u) {
@@ -767,21 +1665,21 @@ private:
 
       // Acceleration adjustment (CV23)
       case 0b0010u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         else if (_own_equal_packets_count == !DCC_STANDARD_COMPLIANCE + 1uz)
           cvWrite(23u - 1u, bytes[1uz]);
         break;
 
       // Deceleration adjustment (CV24)
       case 0b0011u:
-        if (size(bytes) != 2uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 2uz + sizeof(Input::checksum)) return false;
         else if (_own_equal_packets_count == !DCC_STANDARD_COMPLIANCE + 1uz)
           cvWrite(24u - 1u, bytes[1uz]);
         break;
 
       // Extended address 0 and 1 (CV17 and CV18)
       case 0b0100u:
-        if (size(bytes) != 3uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 3uz + sizeof(Input::checksum)) return false;
         else if (_own_equal_packets_count == 2uz) {
           cvWrite(17u - 1u, static_cast<uint8_t>(0b1100'0000u | bytes[1uz]));
           cvWrite(18u - 1u, bytes[2uz]);
@@ -791,7 +1689,7 @@ private:
 
       // Index high and index low (CV31 and CV32)
       case 0b0101u:
-        if (size(bytes) != 3uz + sizeof(_checksum)) return false;
+        if (size(bytes) != 3uz + sizeof(Input::checksum)) return false;
         else if (_own_equal_packets_count == 2uz) {
           cvWrite(31u - 1u, bytes[1uz]);
           cvWrite(32u - 1u, bytes[2uz]);
@@ -923,7 +1821,8 @@ private:
   void binaryState(uint32_t xf, bool state) {
     switch (xf) {
       case 2u:
-        if (!state) tipOffSearch();
+        if constexpr (features.tip_off)
+          if (!state) tipOffSearch();
         break;
       case 4u: break;
       case 5u: break;
@@ -955,45 +1854,58 @@ private:
     }
   }
 
-  /// Reset
+  /// Reset all inputs
   void reset() {
-    _bit_count = _byte = _checksum = 0u;
-    _state = Preamble;
+    for (auto& in : _inputs) reset(in);
+  }
+
+  /// Reset input
+  ///
+  /// \param  in  Input
+  void reset(Input& in) {
+    in.bit_count = in.byte = in.checksum = in.crc = 0u;
+    in.state = Preamble;
   }
 
   /// Enter or exit service mode
   ///
   /// \param  enter Enter service mode
   void serviceMode(bool enter) {
-    // Disable other peripherals which might interfere
-    if (enter) {
-      impl().serviceModeHook(true);
-      _mode = Service;
-    } else {
-      impl().serviceModeHook(false);
-      _mode = Operations;
+    if constexpr (features.service_mode) {
+      // Disable other peripherals which might interfere
+      if (enter) {
+        impl().serviceModeHook(true);
+        _mode = Service;
+      } else {
+        impl().serviceModeHook(false);
+        _mode = Operations;
+      }
     }
   }
 
   /// Add to PoM deque
   ///
   /// \param  value CV value
-  void pom(uint8_t value) {
-    if (!_ch2_data_enabled) return;
-    _pom.deque.clear();
-    _pom.deque.push_back(encode_datagram(make_datagram<Bits::_12>(0u, value)));
+  void pom([[maybe_unused]] uint8_t value) {
+    if constexpr (features.bidi && features.pom) {
+      if (!_ch2_data_enabled) return;
+      _pom.deque.clear();
+      _pom.deque.push_back(
+        encode_datagram(make_datagram<Bits::_12>(0u, value)));
+    }
   }
 
   /// Tip-off search
   void tipOffSearch() {
     using std::literals::chrono_literals::operator""s;
-    if (_tos_backoff || !empty(_tos_deque)) return;
+    if (_cold.tos.backoff || !empty(_cold.tos.deque)) return;
+    auto& tps{_cold.tos.tps};
     auto const now{std::chrono::system_clock::now()};
-    if (std::chrono::duration_cast<std::chrono::seconds>(now - _tps.init) >=
+    if (std::chrono::duration_cast<std::chrono::seconds>(now - tps.init) >=
         30s)
       return;
-    if (_tps.tos == decltype(_tps.tos){}) _tps.tos = now;
-    auto& packet{*end(_tos_deque)};
+    if (tps.tos == decltype(tps.tos){}) tps.tos = now;
+    auto& packet{*end(_cold.tos.deque)};
     auto const adr_high{adrHigh(_addrs.primary)};
     auto it{std::copy(cbegin(adr_high), cend(adr_high), begin(packet))};
     auto const adr_low{adrLow(_addrs.primary)};
@@ -1001,10 +1913,10 @@ private:
     auto const time{encode_datagram(make_datagram<Bits::_12>(
       14u,
       static_cast<uint32_t>(
-        std::chrono::duration_cast<std::chrono::seconds>(_tps.tos - _tps.init)
+        std::chrono::duration_cast<std::chrono::seconds>(tps.tos - tps.init)
           .count())))};
     std::copy(cbegin(time), cend(time), it);
-    _tos_deque.push_back();
+    _cold.tos.deque.push_back();
   }
 
   /// Logon enable
@@ -1014,27 +1926,31 @@ private:
   /// \param  sid Session ID
   void logonEnable(AddressGroup gg, uint16_t cid, uint8_t sid) {
     // Already got selected and CID/SID didn't change
-    if (_logon_selected && _cids.back() == cid && _sids.back() == sid) return;
+    if (_cold.logon.selected && _cold.logon.cids.back() == cid &&
+        _cold.logon.sids.back() == sid)
+      return;
     // ...otherwise clear selected
-    else _logon_selected = false;
+    else _cold.logon.selected = false;
 
     // Store new CID and SID
-    _cids.back() = cid;
-    _sids.back() = sid;
+    _cold.logon.cids.back() = cid;
+    _cold.logon.sids.back() = sid;
 
     // Skip logon if
     // - CIDs are equal and
     // - SIDs are equal if not yet logon assigned or
     // - difference between SIDs is <=1 if already logon assigned
-    if (auto const skip{_cids.back() == _cids.front() &&
-                        static_cast<uint8_t>(_sids.back() - _sids.front()) <=
-                          _logon_assigned}) {
-      _logon_selected = _logon_assigned = _logon_store = true;
+    auto const& logon{_cold.logon};
+    if (auto const skip{
+          logon.cids.back() == logon.cids.front() &&
+          static_cast<uint8_t>(logon.sids.back() - logon.sids.front()) <=
+            logon.assigned}) {
+      _cold.logon.selected = _cold.logon.assigned = _cold.logon.store = true;
       return;
     }
     // ...otherwise force new logon
     else {
-      _logon_assigned = false;
+      _cold.logon.assigned = false;
       _addrs.logon = {};
     }
 
@@ -1042,34 +1958,35 @@ private:
       case AddressGroup::All: [[fallthrough]]; // All decoders
       case AddressGroup::Loco: break;          // Multi-function decoders
       case AddressGroup::Acc: return;          // Accessory decoder
-      case AddressGroup::Now: _logon_backoff.now(); break; // No backoff
+      case AddressGroup::Now: _cold.logon.backoff.now(); break; // No backoff
     }
 
-    if (_logon_backoff) return;
-    assert(!full(_logon_deque));
-    _logon_deque.push_back(encode_datagram(make_datagram<Bits::_48>(
+    if (_cold.logon.backoff) return;
+    assert(!full(_cold.logon.deque));
+    _cold.logon.deque.push_back(encode_datagram(make_datagram<Bits::_48>(
       15u,
       static_cast<uint64_t>(DCC_MANUFACTURER_ID) << 32u |
-        static_cast<uint32_t>(_did[0uz]) << 24u |
-        static_cast<uint32_t>(_did[1uz]) << 16u |
-        static_cast<uint32_t>(_did[2uz]) << 8u |
-        static_cast<uint32_t>(_did[3uz]))));
+        static_cast<uint32_t>(_cold.logon.did[0uz]) << 24u |
+        static_cast<uint32_t>(_cold.logon.did[1uz]) << 16u |
+        static_cast<uint32_t>(_cold.logon.did[2uz]) << 8u |
+        static_cast<uint32_t>(_cold.logon.did[3uz]))));
   }
 
   /// Logon select
   ///
   /// \param  did Unique ID
   void logonSelect(std::span<uint8_t const, 4uz> did) {
-    if (_logon_assigned || !std::ranges::equal(did, _did)) return;
-    _logon_selected = true;
+    if (_cold.logon.assigned || !std::ranges::equal(did, _cold.logon.did))
+      return;
+    _cold.logon.selected = true;
     std::array<uint8_t, 5uz> data{
       static_cast<uint8_t>(ztl::mask<7u> | (_addrs.primary >> 8u)),
       static_cast<uint8_t>(_addrs.primary),
       0u,
       0u,
       0u};
-    assert(!full(_logon_deque));
-    _logon_deque.push_back(encode_datagram(make_datagram<Bits::_48>(
+    assert(!full(_cold.logon.deque));
+    _cold.logon.deque.push_back(encode_datagram(make_datagram<Bits::_48>(
       static_cast<uint64_t>(data[0uz]) << 40u |
       static_cast<uint64_t>(data[1uz]) << 32u |
       static_cast<uint32_t>(data[2uz]) << 24u |
@@ -1085,15 +2002,15 @@ private:
   void logonAssign(std::span<uint8_t const, 4uz> did,
                    AddressAssign bb,
                    Address addr) {
-    if (!std::ranges::equal(did, _did)) return;
-    _logon_assigned = _logon_store = true;
+    if (!std::ranges::equal(did, _cold.logon.did)) return;
+    _cold.logon.assigned = _cold.logon.store = true;
     _addrs.consist = 0u;
     _addrs.logon = addr;
     if (bb == AddressAssign::Permanent && addr) _addrs.primary = addr;
     static constexpr std::array<uint8_t, 5uz> data{
       13u << 4u | 0u, 0u, 0u, 0u, 0u};
-    assert(!full(_logon_deque));
-    _logon_deque.push_back(encode_datagram(make_datagram<Bits::_48>(
+    assert(!full(_cold.logon.deque));
+    _cold.logon.deque.push_back(encode_datagram(make_datagram<Bits::_48>(
       static_cast<uint64_t>(data[0uz]) << 40uz |
       static_cast<uint64_t>(data[1uz]) << 32uz | data[2uz] << 24uz |
       data[3uz] << 16uz | data[4uz] << 8uz | crc8(data))));
@@ -1103,7 +2020,7 @@ private:
   void adr() {
     if (!_ch1_addr_enabled || !empty(_adr_deque)) return;
     // Active address is logon
-    else if (_logon_assigned) {
+    else if (logonAssigned()) {
       _adr_deque.push_back(adrHigh(_addrs.logon));
       _adr_deque.push_back(adrLow(_addrs.logon));
     }
@@ -1144,12 +2061,20 @@ private:
     _adr_deque.pop_front();
   }
 
+  /// Handle app:pom or app:dyn of own address
+  void appPomOrDyn() {
+    if constexpr (features.pom)
+      if (!empty(_pom.deque) || _instr == Instruction::CvLong)
+        return appPom();
+    appDyn();
+  }
+
   /// Handle app:pom
   void appPom() {
     if (!_ch2_data_enabled) return;
     // Deque contains data for this packet
     else if (!empty(_pom.deque) &&
-             (_instr != Instruction::CvLong || _packet == _pom.packet)) {
+             (_instr != Instruction::CvLong || packet() == _pom.packet)) {
       auto const& datagram{_pom.deque.front()};
       std::copy(cbegin(datagram), cend(datagram), begin(_ch2));
       impl().transmitBiDi({cbegin(_ch2), size(datagram)});
@@ -1162,36 +2087,39 @@ private:
 
   /// Handle app:dyn
   void appDyn() {
-    if (empty(_dyn_deque)) return;
-    auto first{begin(_ch2)};
-    auto const last{cend(_ch2)};
-    do {
-      auto const& datagram{_dyn_deque.front()};
-      first = std::copy_n(cbegin(datagram), size(datagram), first);
-      _dyn_deque.pop_front();
-    } while (!empty(_dyn_deque) && last - first >= ssize(_dyn_deque.front()));
-    impl().transmitBiDi({cbegin(_ch2), first});
+    if constexpr (features.dyn) {
+      if (empty(_dyn_deque)) return;
+      auto first{begin(_ch2)};
+      auto const last{cend(_ch2)};
+      do {
+        auto const& datagram{_dyn_deque.front()};
+        first = std::copy_n(cbegin(datagram), size(datagram), first);
+        _dyn_deque.pop_front();
+      } while (!empty(_dyn_deque) &&
+               last - first >= ssize(_dyn_deque.front()));
+      impl().transmitBiDi({cbegin(_ch2), first});
+    }
   }
 
   /// Handle app:tos
   void appTos() {
-    if (empty(_tos_deque)) return;
-    auto const& datagram{_tos_deque.front()};
+    if (empty(_cold.tos.deque)) return;
+    auto const& datagram{_cold.tos.deque.front()};
     std::ranges::copy(datagram, begin(_ch2));
     impl().transmitBiDi({cbegin(_ch2), size(datagram)});
-    _tos_deque.pop_front();
+    _cold.tos.deque.pop_front();
   }
 
   /// Handle app:logon
   void appLogon(uint32_t ch) {
-    if (empty(_logon_deque)) return;
-    if (auto const& datagram{_logon_deque.front()}; ch == 1u) {
+    if (empty(_cold.logon.deque)) return;
+    if (auto const& datagram{_cold.logon.deque.front()}; ch == 1u) {
       std::copy(begin(datagram), begin(datagram) + 2, begin(_ch1));
       impl().transmitBiDi({cbegin(_ch1), size(_ch1)});
     } else {
       std::copy(begin(datagram) + 2, end(datagram), begin(_ch2));
       impl().transmitBiDi({cbegin(_ch2), size(_ch2)});
-      _logon_deque.pop_front();
+      _cold.logon.deque.pop_front();
     }
   }
 
@@ -1235,8 +2163,8 @@ private:
   /// cutout. This is so time-critical that logon information can only be stored
   /// asynchronously...
   void logonStore() {
-    if (!_logon_store) return;
-    _logon_store = false;
+    if (!_cold.logon.store) return;
+    _cold.logon.store = false;
 
     // Logon assign is permanent
     if (_addrs.primary == _addrs.logon) {
@@ -1250,14 +2178,14 @@ private:
     impl().writeCv(19u - 1u, 0u);
     impl().writeCv(20u - 1u, 0u);
 
-    _cids.front() = _cids.back();
+    _cold.logon.cids.front() = _cold.logon.cids.back();
     impl().writeCv(DCC_RX_LOGON_CID_CV_ADDRESS + 0u,
-                   static_cast<uint8_t>(_cids.back() >> 8u));
+                   static_cast<uint8_t>(_cold.logon.cids.back() >> 8u));
     impl().writeCv(DCC_RX_LOGON_CID_CV_ADDRESS + 1u,
-                   static_cast<uint8_t>(_cids.back()));
+                   static_cast<uint8_t>(_cold.logon.cids.back()));
 
-    _sids.front() = _sids.back();
-    impl().writeCv(DCC_RX_LOGON_SID_CV_ADDRESS, _sids.back());
+    _cold.logon.sids.front() = _cold.logon.sids.back();
+    impl().writeCv(DCC_RX_LOGON_SID_CV_ADDRESS, _cold.logon.sids.back());
 
     std::array<uint8_t, 2uz> cv65300_65301;
     encode_address(_addrs.logon, begin(cv65300_65301));
@@ -1265,91 +2193,140 @@ private:
     impl().writeCv(DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 1u, cv65300_65301[1uz]);
   }
 
-  /// Update quality of service (roughly every second)
-  ///
-  /// \return Quality of service
-  void updateQos() {
-    if (_preamble_count < 100u) return;
-    _qos =
-      static_cast<uint8_t>(100u - (_packet_count * 100u) / _preamble_count);
-    _packet_count = _preamble_count = 0u;
-  }
-
   /// Update time points
   ///
   /// In case time between two packets is >=2s allow tip-off search again.
   void updateTimePoints() {
     using std::literals::chrono_literals::operator""s;
     auto const now{std::chrono::system_clock::now()};
-    if (now - _tps.packet >= 2s) {
-      _tos_backoff.now();
-      _tps.tos = decltype(_tps.tos){};
+    if (now - _cold.tos.tps.packet >= 2s) {
+      _cold.tos.backoff.now();
+      _cold.tos.tps.tos = decltype(_cold.tos.tps.tos){};
     }
-    _tps.packet = now;
+    _cold.tos.tps.packet = now;
   }
 
+  // Hot state, accessed in handler mode on every edge or packet
+  alignas(std::max(Cfg.cache_line, alignof(Input)))
+    std::array<Input, Cfg.inputs> _inputs{};
+  Packet const* _packet{}; ///< Last received packet
+  Qos<Cfg.qos_window> _qos{}; ///< Quality of service
+  Instruction _instr{};       ///< Current instruction
+  // Not bitfields as those are most likely mutated in interrupt context
+  std::atomic<bool> _packet_end{}; ///< Written in handler mode only
+  [[no_unique_address]] std::conditional_t<Cfg.histogram, bool, std::monostate>
+    _histogram{}; ///< Histogram currently recorded
+  [[no_unique_address]] std::
+    conditional_t<Cfg.statistics, Statistics, std::monostate> _statistics{};
+  [[no_unique_address]] std::
+    conditional_t<(Cfg.inputs > 1uz), Dedup, std::monostate> _dedup{};
+
+  // Address filter and handler mode
+  struct Filter {
+    bool service{}; ///< Service mode as seen by handler mode
+    size_t hold{};  ///< Queued packets thread mode has to execute first
+  };
+  [[no_unique_address]] std::conditional_t<Cfg.address_filter ||
+                                             Cfg.handler_mode,
+                                           Filter,
+                                           std::monostate> _filter{};
+
+  /// Packets bypassed the deque since last execute
+  [[no_unique_address]] std::conditional_t<Cfg.address_filter ||
+                                             Cfg.handler_mode,
+                                           bool,
+                                           std::monostate> _bypassed{};
+
+  // Emergency stop priority slot
+  struct Priority {
+    Address::value_type addr{}; ///< Address of emergency stop
+    bool dir{};                 ///< Direction of emergency stop
+    bool pending{};             ///< Emergency stop pending
+    size_t stale{};             ///< Packets queued before emergency stop
+  };
+  [[no_unique_address]] std::
+    conditional_t<Cfg.priority_estop, Priority, std::monostate> _priority{};
+
+  Addresses _addrs{};
+
   // Deques
-  ztl::inplace_deque<Packet, DCC_RX_DEQUE_SIZE> _deque{};
-  ztl::inplace_deque<Datagram<datagram_size<Bits::_18>>, DCC_RX_BIDI_DEQUE_SIZE>
-    _dyn_deque{};
-  ztl::inplace_deque<Datagram<datagram_size<Bits::_48>>, 1uz> _logon_deque{};
-  ztl::inplace_deque<Datagram<datagram_size<Bits::_36>>, 1uz> _tos_deque{};
-  ztl::inplace_deque<Datagram<datagram_size<Bits::_12>>, 2uz> _adr_deque{};
+  std::conditional_t<Cfg.compact_deque,
+                     CompactRing<Cfg.compact_deque, Cfg.smp>,
+                     Ring<std::conditional_t<Cfg.coalesce, Repeated, Packet>,
+                          DCC_RX_DEQUE_SIZE,
+                          Cfg.smp>>
+    _deque{};
+  [[no_unique_address]] std::conditional_t<
+    features.dyn,
+    ztl::inplace_deque<Datagram<datagram_size<Bits::_18>>,
+                       DCC_RX_BIDI_DEQUE_SIZE>,
+    std::monostate> _dyn_deque{};
+  [[no_unique_address]] std::conditional_t<
+    features.bidi,
+    ztl::inplace_deque<Datagram<datagram_size<Bits::_12>>, 2uz>,
+    std::monostate> _adr_deque{};
 
   // PoM
-  struct {
+  struct Pom {
     ztl::inplace_deque<Datagram<datagram_size<Bits::_12>>, 1uz> deque{};
     Packet packet{};
-  } _pom{};
+  };
+  [[no_unique_address]] std::
+    conditional_t<features.bidi && features.pom, Pom, std::monostate> _pom{};
 
-  Packet _packet{};          ///< Current packet
   Packet _last_own_packet{}; ///< Last packet for own address
 
-  Addresses _addrs{};
+  [[no_unique_address]] std::conditional_t<Cfg.histogram,
+                                           std::array<Histogram, 2uz>,
+                                           std::monostate> _histograms{};
 
-  size_t _bit_count{};
-  size_t _packet_count{};
-  size_t _preamble_count{};
   size_t _own_equal_packets_count{};
-  Instruction _instr{}; ///< Current instruction
-  uint8_t _byte{};
-  uint8_t _checksum{};    ///< On-the-fly calculated checksum
   uint8_t _index_reg{1u}; ///< Paged mode index register
 
-  enum State : uint8_t { Preamble, Startbit, Data, Endbit } _state{};
-  enum Mode : uint8_t { Operations, Service } _mode{};
-
-  // Time points
-  struct {
-    std::chrono::time_point<std::chrono::system_clock> init;
-    std::chrono::time_point<std::chrono::system_clock> packet;
-    std::chrono::time_point<std::chrono::system_clock> tos;
-  } _tps{};
-
-  std::array<uint8_t, 4uz> _did{};
+  [[no_unique_address]] std::
+    conditional_t<features.service_mode, Mode, std::monostate> _mode{};
 
   // Buffers
-  Channel1 _ch1{};
-  Channel2 _ch2{};
-
-  Backoff _logon_backoff{};
-  Backoff _tos_backoff{};
-
-  std::array<uint16_t, 2uz> _cids{}; ///< Central ID
-  std::array<uint8_t, 2uz> _sids{};  ///< Session ID
-
-  uint8_t _qos{}; ///< Quality of service
+  [[no_unique_address]] std::
+    conditional_t<features.bidi, Channel1, std::monostate> _ch1{};
+  [[no_unique_address]] std::
+    conditional_t<features.bidi, Channel2, std::monostate> _ch2{};
+
+  // Logon
+  struct Logon {
+    ztl::inplace_deque<Datagram<datagram_size<Bits::_48>>, 1uz> deque{};
+    Backoff backoff{};
+    std::array<uint16_t, 2uz> cids{}; ///< Central ID
+    std::array<uint8_t, 2uz> sids{};  ///< Session ID
+    std::array<uint8_t, 4uz> did{};
+    bool enabled{};
+    bool selected{};
+    bool assigned{};
+    bool store{};
+  };
+
+  // Tip-off search
+  struct TipOff {
+    struct {
+      std::chrono::time_point<std::chrono::system_clock> init;
+      std::chrono::time_point<std::chrono::system_clock> packet;
+      std::chrono::time_point<std::chrono::system_clock> tos;
+    } tps{};
+    ztl::inplace_deque<Datagram<datagram_size<Bits::_36>>, 1uz> deque{};
+    Backoff backoff{};
+  };
+
+  // Cold state, logon, tip-off search and time points
+  struct {
+    [[no_unique_address]] std::
+      conditional_t<features.logon, Logon, std::monostate> logon{};
+    [[no_unique_address]] std::
+      conditional_t<features.tip_off, TipOff, std::monostate> tos{};
+  } _cold{};
 
-  // Not bitfields as those are most likely mutated in interrupt context
-  bool _is_halfbit{};
-  bool _packet_end{};
   bool _ch1_addr_enabled{};
   bool _ch2_data_enabled{};
   bool _ch2_consist_enabled{};
-  bool _logon_enabled{};
-  bool _logon_selected{};
-  bool _logon_assigned{};
-  bool _logon_store{};
 
   bool _enabled : 1 {};
   bool _cvs_locked : 1 {};
@@ -0,0 +1,23 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Cutout
+///
+/// \file   dcc/rx/cutout.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+namespace dcc::rx {
+
+template<typename T>
+concept Cutout = requires(T t, uint32_t ch1_offset, uint32_t ch2_offset) {
+  { t.cutoutStart(ch1_offset, ch2_offset) };
+};
+
+} // namespace dcc::rx
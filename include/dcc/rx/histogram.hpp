@@ -0,0 +1,40 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Histogram of half bit timings
+///
+/// \file   dcc/rx/histogram.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace dcc::rx {
+
+/// Histogram of half bit timings
+///
+/// Times are sorted into bins of 4µs, which covers the 1-bit and 0-bit
+/// windows in fine steps. The last bin counts all times which are longer
+/// (stretched 0-bits, analog).
+struct Histogram {
+  static constexpr uint32_t bin_width{4u}; ///< Width of a single bin in µs
+
+  /// Add time
+  ///
+  /// \param  time  Time in µs
+  constexpr void add(uint32_t time) {
+    ++bins[std::min<size_t>(time / bin_width, size(bins) - 1uz)];
+  }
+
+  /// Clear all bins
+  constexpr void clear() { bins = {}; }
+
+  std::array<uint32_t, 33uz> bins{}; ///< Bins, [0, 4), [4, 8), ..., [128, ∞)
+};
+
+} // namespace dcc::rx
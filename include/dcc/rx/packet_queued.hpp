@@ -0,0 +1,22 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Packet queued
+///
+/// \file   dcc/rx/packet_queued.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <concepts>
+
+namespace dcc::rx {
+
+template<typename T>
+concept PacketQueued = requires(T t) {
+  { t.packetQueued() };
+};
+
+} // namespace dcc::rx
@@ -0,0 +1,57 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Quality of service
+///
+/// \file   dcc/rx/qos.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace dcc::rx {
+
+/// Quality of service
+///
+/// Exponentially weighted moving average of lost packets in percent. Every
+/// packet gets weighted with 1/Window, so an update only costs a shift and an
+/// addition. The average is updated in handler mode and read in thread mode,
+/// which might run on another core. It doesn't guard any other data, so
+/// relaxed atomic accesses suffice.
+///
+/// \tparam Window  Window in packets (power of 2)
+template<size_t Window>
+requires(std::has_single_bit(Window) && Window <= 256uz)
+struct Qos {
+  /// Update with outcome of a single packet
+  ///
+  /// \param  lost  Packet lost
+  void update(bool lost) {
+    auto const avg{_avg.load(std::memory_order_relaxed)};
+    _avg.store(lost ? static_cast<uint16_t>(avg + ((max - avg) >> shift))
+                    : static_cast<uint16_t>(avg - (avg >> shift)),
+               std::memory_order_relaxed);
+  }
+
+  /// Get lost packets in percent
+  ///
+  /// \return Lost packets in percent
+  operator uint8_t() const {
+    return static_cast<uint8_t>((_avg.load(std::memory_order_relaxed) + 128u) >>
+                                8u);
+  }
+
+private:
+  static constexpr auto shift{std::countr_zero(Window)};
+  static constexpr uint32_t max{100u << 8u};
+
+  std::atomic<uint16_t> _avg{}; ///< Average of lost packets in 1/256 percent
+};
+
+} // namespace dcc::rx
@@ -0,0 +1,193 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Ring buffer
+///
+/// \file   dcc/rx/ring.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace dcc::rx {
+
+namespace detail {
+
+/// Read index written by the other side of a ring
+///
+/// \tparam Smp Producer and consumer run on different cores
+/// \param  i   Index
+/// \return Value of index
+template<bool Smp, typename I>
+I load(std::atomic<I> const& i) {
+  if constexpr (Smp) return i.load(std::memory_order_acquire);
+  else {
+    auto const retval{i.load(std::memory_order_relaxed)};
+    std::atomic_signal_fence(std::memory_order_acquire);
+    return retval;
+  }
+}
+
+/// Publish index of a ring
+///
+/// \tparam Smp   Producer and consumer run on different cores
+/// \param  i     Index
+/// \param  value Value of index
+template<bool Smp, typename I>
+void store(std::atomic<I>& i, I value) {
+  if constexpr (Smp) i.store(value, std::memory_order_release);
+  else {
+    std::atomic_signal_fence(std::memory_order_release);
+    i.store(value, std::memory_order_relaxed);
+  }
+}
+
+} // namespace detail
+
+/// Single-producer/single-consumer ring buffer which allows constructing
+/// elements in place
+///
+/// The ring keeps one additional slot which is never visible to the consumer.
+/// The producer can fill this slot directly through \ref next and then either
+/// commit or simply discard it by not committing. The slot stays valid even if
+/// the ring is full.
+///
+/// The tail is only written by the producer and the head only by the
+/// consumer. Publishing an index has release, reading the other side's index
+/// acquire semantics. Unless Smp is set, this only prevents the compiler from
+/// reordering, which is sufficient if producer and consumer (e.g. interrupt
+/// and thread) run on the same core.
+///
+/// \tparam T   Type of elements
+/// \tparam N   Capacity
+/// \tparam Smp Producer and consumer run on different cores
+template<typename T, size_t N, bool Smp = false>
+struct Ring {
+  using value_type = T;
+  using size_type = size_t;
+
+  /// Slot of next element (producer)
+  ///
+  /// \return Slot of next element
+  T& next() { return _data[_tail.load(std::memory_order_relaxed)]; }
+
+  /// Make next element visible to consumer (producer)
+  void commit() {
+    store(_tail, wrap(_tail.load(std::memory_order_relaxed) + 1uz));
+  }
+
+  /// Copy element to end (producer)
+  ///
+  /// \param  value Element
+  void push_back(T const& value) {
+    next() = value;
+    commit();
+  }
+
+  /// Access first element (consumer)
+  ///
+  /// \return First element
+  T& front() { return _data[_head.load(std::memory_order_relaxed)]; }
+
+  /// Access first element (consumer)
+  ///
+  /// \return First element
+  T const& front() const {
+    return _data[_head.load(std::memory_order_relaxed)];
+  }
+
+  /// Access last element (producer)
+  ///
+  /// \return Last element
+  T& back() {
+    auto const tail{_tail.load(std::memory_order_relaxed)};
+    return _data[tail ? tail - 1uz : N];
+  }
+
+  /// Access last element (producer)
+  ///
+  /// \return Last element
+  T const& back() const {
+    auto const tail{_tail.load(std::memory_order_relaxed)};
+    return _data[tail ? tail - 1uz : N];
+  }
+
+  /// Access element (producer or consumer)
+  ///
+  /// \param  pos Position of element relative to first element
+  /// \return Element
+  T& operator[](size_type pos) {
+    auto const i{load(_head) + pos};
+    return _data[i > N ? i - (N + 1uz) : i];
+  }
+
+  /// Remove element and commit next element (producer)
+  ///
+  /// All elements behind the removed one move up by one position, including
+  /// the next element. The consumer must not access any of these, so this is
+  /// only safe if the consumer can't run concurrently (e.g. when called from an
+  /// interrupt on the same core).
+  ///
+  /// \param  pos Position of element relative to first element
+  void replace(size_type pos) {
+    auto const tail{_tail.load(std::memory_order_relaxed)};
+    auto const i{load(_head) + pos};
+    for (auto j{i > N ? i - (N + 1uz) : i}; j != tail; j = wrap(j + 1uz))
+      _data[j] = _data[wrap(j + 1uz)];
+  }
+
+  /// Remove first element (consumer)
+  void pop_front() {
+    store(_head, wrap(_head.load(std::memory_order_relaxed) + 1uz));
+  }
+
+  /// Remove all elements (consumer)
+  void clear() { store(_head, load(_tail)); }
+
+  /// Number of elements
+  ///
+  /// \return Number of elements
+  size_type size() const {
+    auto const head{load(_head)};
+    auto const tail{load(_tail)};
+    return tail >= head ? tail - head : tail + N + 1uz - head;
+  }
+
+  /// Maximum number of elements
+  ///
+  /// \return Maximum number of elements
+  static constexpr size_type max_size() { return N; }
+
+  /// Maximum number of elements
+  ///
+  /// \return Maximum number of elements
+  static constexpr size_type capacity() { return N; }
+
+  friend size_type size(Ring const& r) { return r.size(); }
+  friend bool empty(Ring const& r) { return load(r._head) == load(r._tail); }
+  friend bool full(Ring const& r) { return r.size() == N; }
+
+private:
+  static constexpr size_type wrap(size_type i) {
+    return i == N + 1uz ? 0uz : i;
+  }
+
+  static size_type load(std::atomic<size_type> const& i) {
+    return detail::load<Smp>(i);
+  }
+
+  static void store(std::atomic<size_type>& i, size_type value) {
+    detail::store<Smp>(i, value);
+  }
+
+  std::array<T, N + 1uz> _data{};
+  std::atomic<size_type> _head{}; ///< Written by consumer
+  std::atomic<size_type> _tail{}; ///< Written by producer
+};
+
+} // namespace dcc::rx
@@ -0,0 +1,35 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Receive statistics
+///
+/// \file   dcc/rx/statistics.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <cstdint>
+
+namespace dcc::rx {
+
+/// Receive statistics
+///
+/// All counters are free-running and wrap around, so rates are best taken from
+/// the differences of two snapshots. Each counter is only ever incremented by
+/// either handler or thread mode. The difference between accepted and executed
+/// packets minus the ones dropped from or replaced in the deque is the current
+/// fill level of the deque.
+struct Statistics {
+  uint32_t invalid_timings{};    ///< Times outside of the timing windows
+  uint32_t preamble_aborts{};    ///< Startbits after a too short preamble
+  uint32_t checksum_errors{};    ///< Packets with invalid checksum
+  uint32_t deque_overflows{};    ///< Newest packets dropped on full deque
+  uint32_t deque_drops{};        ///< Oldest packets dropped on full deque
+  uint32_t deque_replacements{}; ///< Packets replaced on full deque
+  uint32_t packets_accepted{};   ///< Packets pushed to the deque
+  uint32_t packets_executed{};   ///< Packets executed from the deque
+};
+
+} // namespace dcc::rx
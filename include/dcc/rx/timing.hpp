@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include "../bit.hpp"
 
@@ -25,14 +27,45 @@ enum Timing {
   Bit0MaxAnalog = 10000u             ///< Maximal timing for half a 0-bit analog
 };
 
+/// Timing windows for half a bit
+struct TimingWindows {
+  uint32_t bit1_min{Bit1Min};       ///< Minimal timing for half a 1-bit
+  uint32_t bit1_max{Bit1Max};       ///< Maximal timing for half a 1-bit
+  uint32_t bit0_min{Bit0Min};       ///< Minimal timing for half a 0-bit
+  uint32_t bit0_max{Bit0MaxAnalog}; ///< Maximal timing for half a 0-bit
+};
+
+namespace detail {
+
+/// Lookup table for all times shorter than the minimal timing of a 0-bit
+///
+/// \tparam Ws  Timing windows
+template<TimingWindows Ws>
+inline constexpr auto time2bit_lut{[] {
+  std::array<Bit, Ws.bit0_min> lut{};
+  std::ranges::fill(lut, Invalid);
+  std::ranges::fill_n(
+    begin(lut) + Ws.bit1_min, Ws.bit1_max - Ws.bit1_min + 1u, _1);
+  return lut;
+}()};
+
+} // namespace detail
+
 /// Convert time to bit
 ///
+/// Times shorter than the minimal timing of a 0-bit are looked up in a table,
+/// which leaves a single compare for everything else.
+///
+/// \tparam Ws    Timing windows
 /// \param  time  Time in µs
 /// \return Bit
+template<TimingWindows Ws = TimingWindows{}>
+requires(Ws.bit1_min <= Ws.bit1_max && Ws.bit1_max < Ws.bit0_min &&
+         Ws.bit0_min <= Ws.bit0_max)
 constexpr Bit time2bit(uint32_t time) {
-  if (time >= Bit1Min && time <= Bit1Max) return _1;
-  else if (time >= Bit0Min && time <= Bit0MaxAnalog) return _0;
-  else return Invalid;
+  if (time < size(detail::time2bit_lut<Ws>))
+    return detail::time2bit_lut<Ws>[time];
+  return time <= Ws.bit0_max ? _0 : Invalid;
 }
 
 } // namespace dcc::rx
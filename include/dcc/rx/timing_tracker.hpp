@@ -0,0 +1,126 @@
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+/// Timing tracker
+///
+/// \file   dcc/rx/timing_tracker.hpp
+/// \author Vincent Hamp
+/// \date   17/10/2026
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include "timing.hpp"
+
+namespace dcc::rx {
+
+/// Learns the bit timings of the command station
+///
+/// The timings of half 1-bits and 0-bits are tracked with a running median of
+/// the last three samples. Both halves of a bit are tracked separately, so
+/// that asymmetric bits (e.g. 1-bits with halves differing by up to 6µs,
+/// which S-9.1 requires decoders to accept) don't fall outside the windows.
+/// Once learned, bits get classified against windows spanning the timings of
+/// both halves plus tolerance. Tracked windows never exceed the standard ones,
+/// until then the standard windows are used.
+///
+/// \tparam Ws  Standard timing windows
+/// \tparam Tol Tolerance around tracked timings in µs
+template<TimingWindows Ws, uint32_t Tol>
+struct TimingTracker {
+  static_assert(Tol && Tol < Ws.bit1_min);
+
+  /// Add time of half a 1-bit
+  ///
+  /// \param  time  Time in µs
+  constexpr void bit1(uint32_t time) {
+    if (!add(_bit1, time)) return;
+    auto const [min, max]{std::minmax(_bit1[0uz].value(), _bit1[1uz].value())};
+    _bit1_min = std::max(Ws.bit1_min, min - Tol);
+    _bit1_max = std::min(Ws.bit1_max, max + Tol);
+  }
+
+  /// Add time of half a 0-bit
+  ///
+  /// Stretched 0-bits are ignored.
+  ///
+  /// \param  time  Time in µs
+  constexpr void bit0(uint32_t time) {
+    if (time > Bit0Max || !add(_bit0, time)) return;
+    auto const min{std::min(_bit0[0uz].value(), _bit0[1uz].value())};
+    _bit0_min = std::max(Ws.bit0_min, min - Tol);
+  }
+
+  /// Convert time to bit using tracked windows
+  ///
+  /// \param  time  Time in µs
+  /// \return Bit
+  constexpr Bit time2bit(uint32_t time) const {
+    if (time - _bit1_min <= _bit1_max - _bit1_min) return _1;
+    else if (time >= _bit0_min && time <= Ws.bit0_max) return _0;
+    else return Invalid;
+  }
+
+private:
+  /// Running median of the last three samples
+  struct Median {
+    /// Add sample
+    ///
+    /// \param  sample  Sample
+    /// \retval true    Median valid
+    /// \retval false   Median not yet valid
+    constexpr bool add(uint32_t sample) {
+      _samples[_i] = static_cast<uint16_t>(sample);
+      _i = _i == size(_samples) - 1uz ? 0u : _i + 1u;
+      if (_count < size(_samples)) ++_count;
+      return valid();
+    }
+
+    /// Check if median is valid
+    ///
+    /// \retval true  Median valid
+    /// \retval false Median not yet valid
+    constexpr bool valid() const { return _count == size(_samples); }
+
+    /// Get median
+    ///
+    /// \return Median
+    constexpr uint32_t value() const {
+      auto const [a, b, c]{_samples};
+      return std::max(std::min(a, b), std::min(std::max(a, b), c));
+    }
+
+  private:
+    std::array<uint16_t, 3uz> _samples{};
+    uint8_t _i{};
+    uint8_t _count{};
+  };
+
+  /// Halves of a bit
+  struct Halves : std::array<Median, 2uz> {
+    bool second{}; ///< Next sample is second half
+  };
+
+  /// Add sample to alternating halves
+  ///
+  /// \param  halves  Halves
+  /// \param  sample  Sample
+  /// \retval true    Medians of both halves valid
+  /// \retval false   Medians not yet valid
+  static constexpr bool add(Halves& halves, uint32_t sample) {
+    halves[halves.second].add(sample);
+    halves.second = !halves.second;
+    return halves[0uz].valid() && halves[1uz].valid();
+  }
+
+  Halves _bit1{};
+  Halves _bit0{};
+  uint32_t _bit1_min{Ws.bit1_min};
+  uint32_t _bit1_max{Ws.bit1_max};
+  uint32_t _bit0_min{Ws.bit0_min};
+};
+
+} // namespace dcc::rx
@@ -79,6 +79,30 @@ TEST(address, decode_address) {
   }
 }
 
+TEST(address, decode_header) {
+  EXPECT_EQ(dcc::decode_header(0u).type, dcc::Address::Broadcast);
+  EXPECT_EQ(dcc::decode_header(0u).size, 1u);
+  EXPECT_EQ(dcc::decode_header(0b0000'0011u).type, dcc::Address::BasicLoco);
+  EXPECT_EQ(dcc::decode_header(0b0000'0011u).size, 1u);
+  EXPECT_EQ(dcc::decode_header(0b1011'0011u).type,
+            dcc::Address::BasicAccessory);
+  EXPECT_EQ(dcc::decode_header(0b1011'0011u).size, 2u);
+  EXPECT_EQ(dcc::decode_header(0b1101'0011u).type, dcc::Address::ExtendedLoco);
+  EXPECT_EQ(dcc::decode_header(0b1101'0011u).size, 2u);
+  EXPECT_EQ(dcc::decode_header(0b1111'1110u).type,
+            dcc::Address::AutomaticLogon);
+  EXPECT_EQ(dcc::decode_header(0b1111'1110u).size, 1u);
+  EXPECT_EQ(dcc::decode_header(0b1111'1111u).type, dcc::Address::Idle);
+  EXPECT_EQ(dcc::decode_header(0b1111'1111u).size, 1u);
+
+  // Header and address agree on type
+  for (auto i{0u}; i <= 255u; ++i) {
+    std::array<uint8_t, 2uz> data{static_cast<uint8_t>(i), 0b1000'0000u};
+    EXPECT_EQ(dcc::decode_address(cbegin(data)).type,
+              dcc::decode_header(data[0uz]).type);
+  }
+}
+
 TEST(address, encode_address) {
   {
     std::array<uint8_t, 2uz> data{};
@@ -18,3 +18,8 @@ TEST(instruction, decode_instruction_long_address) {
               dcc::Instruction::ConsistControl);
   }
 }
+
+TEST(instruction, decode_instruction_broadcast_address) {
+  auto packet{dcc::make_reset_packet()};
+  EXPECT_EQ(dcc::decode_instruction(packet), dcc::Instruction::DecoderControl);
+}
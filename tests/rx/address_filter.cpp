@@ -0,0 +1,76 @@
+#include "rx_test.hpp"
+
+using AddressFilterTest = BasicRxTest<dcc::rx::Config{.statistics = true,
+                                                      .address_filter = true}>;
+
+TEST_F(AddressFilterTest, drops_foreign_packets) {
+  // Foreign packets don't fill deque
+  for (auto i{0uz}; i < DCC_RX_DEQUE_SIZE + 2uz; ++i)
+    Receive(dcc::make_function_group_f4_f0_packet(42u, 0b1'0001u))
+      ->LeaveCutout();
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u))->LeaveCutout();
+  auto const statistics{_mock.statistics()};
+  EXPECT_EQ(statistics.packets_accepted, 1u);
+  EXPECT_EQ(statistics.deque_overflows, 0u);
+
+  EXPECT_CALL(_mock, function(_addrs.primary.value, _, _));
+  while (_mock.execute());
+  EXPECT_EQ(_mock.statistics().packets_executed, 1u);
+}
+
+TEST_F(AddressFilterTest, keeps_service_mode_packets) {
+  // Don't write any CV which might trigger config (e.g. 1, 28, ...)!
+  auto cv_addr{RandomInterval(30u, smath::pow(2u, 10u) - 1u)};
+  auto byte{RandomInterval<uint8_t>(0u, 255u)};
+  auto packet{dcc::make_cv_access_long_write_service_packet(cv_addr, byte)};
+
+  // Service mode packets get received before reset packet is executed
+  Receive(dcc::make_reset_packet())->LeaveCutout();
+  for (auto i{0uz}; i < 5uz; ++i) Receive(packet)->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().packets_accepted, 6u);
+
+  EXPECT_CALL(_mock, serviceModeHook(true));
+  EXPECT_CALL(_mock, writeCv(cv_addr, byte));
+  while (_mock.execute());
+  EXPECT_TRUE(_mock.serviceMode());
+}
+
+TEST_F(AddressFilterTest, keeps_counting_own_equal_packets) {
+  // Don't write any CV which might trigger config (e.g. 1, 28, ...)!
+  auto cv_addr{RandomInterval(30u, smath::pow(2u, 10u) - 1u)};
+  auto byte{RandomInterval<uint8_t>(0u, 255u)};
+  auto packet{
+    make_cv_access_long_write_packet(_addrs.primary, cv_addr, byte)};
+
+  // Foreign packets in between own ones don't reset count
+  EXPECT_CALL(_mock,
+              writeCv(Matcher<uint32_t>(cv_addr),
+                      Matcher<uint8_t>(byte),
+                      Matcher<std::function<void(uint8_t)>>(_)));
+  for (auto i{0uz}; i < 2uz; ++i) {
+    Receive(packet)->LeaveCutout();
+    Receive(dcc::make_function_group_f4_f0_packet(42u, 0u))->LeaveCutout();
+    while (_mock.execute());
+  }
+}
+
+TEST_F(AddressFilterTest, follows_queued_address_change) {
+  auto const packet{
+    make_cv_access_long_write_packet(_addrs.primary, 1u - 1u, 5u)};
+
+  // Packet for new address gets received before CV1 is written
+  Receive(packet)->LeaveCutout();
+  Receive(packet)->LeaveCutout();
+  Receive(dcc::make_function_group_f4_f0_packet(5u, 0b1'0000u))->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().packets_accepted, 3u);
+
+  _cvs[1uz - 1uz] = 5u;
+  BASIC_ADDRESS_EXPECT_CALL_READ_CV_INIT_SEQUENCE();
+  EXPECT_CALL(_mock,
+              writeCv(Matcher<uint32_t>(1u - 1u),
+                      Matcher<uint8_t>(5u),
+                      Matcher<std::function<void(uint8_t)>>(_)))
+    .WillOnce(InvokeArgument<2uz>(5u));
+  EXPECT_CALL(_mock, function(5u, _, _));
+  while (_mock.execute());
+}
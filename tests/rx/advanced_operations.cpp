@@ -24,6 +24,20 @@ TEST_F(RxTest, speed_direction_and_functions_f23_f0) {
       _addrs.primary, dcc::Forward << 7u | 10u, 1u, 2u, 3u));
 }
 
+// Speed, direction and functions F31-F0
+TEST_F(RxTest, speed_direction_and_functions_f31_f0) {
+  EXPECT_CALL(_mock, direction(_addrs.primary.value, dcc::Forward));
+  EXPECT_CALL(_mock,
+              speed(_addrs.primary.value, dcc::scale_speed<126>(10 - 1)));
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0xFFu << 0u, 1u << 0u));
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0xFFu << 8u, 2u << 8u));
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0xFFu << 16u, 3u << 16u));
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0xFFu << 24u, 4u << 24u));
+  ReceiveAndExecute(
+    make_advanced_operations_speed_direction_and_functions_packet(
+      _addrs.primary, dcc::Forward << 7u | 10u, 1u, 2u, 3u, 4u));
+}
+
 // 126 speed steps command forward
 TEST_F(RxTest, _126_speed_steps_fwd) {
   EXPECT_CALL(_mock, direction(_addrs.primary.value, dcc::Forward));
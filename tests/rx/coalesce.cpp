@@ -0,0 +1,39 @@
+#include "rx_test.hpp"
+
+using CoalesceTest =
+  BasicRxTest<dcc::rx::Config{.statistics = true, .coalesce = true}>;
+
+TEST_F(CoalesceTest, repetitions) {
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, 0u)};
+
+  // Repetitions don't fill deque
+  for (auto i{0uz}; i < 2uz * DCC_RX_DEQUE_SIZE; ++i)
+    Receive(packet)->LeaveCutout();
+  auto statistics{_mock.statistics()};
+  EXPECT_EQ(statistics.packets_accepted, 2uz * DCC_RX_DEQUE_SIZE);
+  EXPECT_EQ(statistics.deque_overflows, 0u);
+
+  // Each repetition still gets executed
+  EXPECT_CALL(_mock, function(_addrs.primary.value, _, _))
+    .Times(2 * DCC_RX_DEQUE_SIZE);
+  while (_mock.execute());
+  EXPECT_EQ(_mock.statistics().packets_executed, 2uz * DCC_RX_DEQUE_SIZE);
+}
+
+TEST_F(CoalesceTest, keeps_counting_own_equal_packets) {
+  // Don't write any CV which might trigger config (e.g. 1, 28, ...)!
+  auto cv_addr{RandomInterval(30u, smath::pow(2u, 10u) - 1u)};
+  auto byte{RandomInterval<uint8_t>(0u, 255u)};
+  auto packet{
+    make_cv_access_long_write_packet(_addrs.primary, cv_addr, byte)};
+
+  // Write exactly once, even if repetitions got coalesced
+  EXPECT_CALL(_mock,
+              writeCv(Matcher<uint32_t>(cv_addr),
+                      Matcher<uint8_t>(byte),
+                      Matcher<std::function<void(uint8_t)>>(_)));
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u))->LeaveCutout();
+  for (auto i{0uz}; i < 4uz; ++i) Receive(packet)->LeaveCutout();
+  while (_mock.execute());
+  EXPECT_EQ(_mock.statistics().packets_executed, 5u);
+}
@@ -0,0 +1,61 @@
+#include "rx_test.hpp"
+
+TEST(CompactRingTest, packets_of_different_size) {
+  dcc::rx::CompactRing<32uz> ring;
+  EXPECT_TRUE(empty(ring));
+
+  // Each packet takes its size plus a length byte
+  ring.push_back(dcc::Packet{0x03u, 0x3Fu, 0x80u, 0xBCu});
+  ring.push_back(dcc::Packet{0x03u, 0x80u, 0x83u});
+  ring.next() = dcc::Packet{0xFFu, 0x00u, 0xFFu};
+  EXPECT_EQ(size(ring), 2uz);
+  EXPECT_FALSE(full(ring));
+
+  EXPECT_EQ(ring.front(), (dcc::Packet{0x03u, 0x3Fu, 0x80u, 0xBCu}));
+  ring.pop_front();
+  EXPECT_EQ(ring.front(), (dcc::Packet{0x03u, 0x80u, 0x83u}));
+  ring.pop_front();
+  EXPECT_TRUE(empty(ring));
+}
+
+TEST(CompactRingTest, full_depends_on_next_packet) {
+  dcc::rx::CompactRing<32uz> ring;
+  for (auto i{0u}; i < 7u; ++i)
+    ring.push_back(dcc::Packet{0x03u, 0x80u, static_cast<uint8_t>(i)});
+  EXPECT_EQ(size(ring), 7uz);
+
+  // 4 bytes left
+  ring.next() = dcc::Packet{0x03u, 0x80u, 0x83u};
+  EXPECT_FALSE(full(ring));
+  ring.next() = dcc::Packet{0x03u, 0x3Fu, 0x80u, 0xBCu};
+  EXPECT_TRUE(full(ring));
+}
+
+TEST(CompactRingTest, wraparound) {
+  dcc::rx::CompactRing<32uz> ring;
+  for (auto i{0u}; i < 100u; ++i) {
+    dcc::Packet packet;
+    packet.resize(3uz + i % 5uz);
+    for (auto& byte : packet) byte = static_cast<uint8_t>(i);
+    ring.push_back(packet);
+    EXPECT_EQ(ring.front(), packet);
+    ring.pop_front();
+  }
+  EXPECT_TRUE(empty(ring));
+}
+
+using CompactDequeTest = BasicRxTest<dcc::rx::Config{
+  .statistics = true, .compact_deque = 256uz}>;
+
+TEST_F(CompactDequeTest, holds_more_packets) {
+  // 256 bytes hold twice as many function packets as the default deque
+  auto const n{2uz * DCC_RX_DEQUE_SIZE};
+  for (auto i{0uz}; i < n; ++i)
+    Receive(make_function_group_f4_f0_packet(_addrs.primary,
+                                             static_cast<uint8_t>(i & 0x1Fu)))
+      ->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().deque_overflows, 0u);
+
+  EXPECT_CALL(_mock, function(_addrs.primary.value, _, _)).Times(n);
+  EXPECT_EQ(_mock.execute(n), n);
+}
@@ -0,0 +1,38 @@
+#include "rx_test.hpp"
+
+using namespace dcc::bidi;
+
+TEST_F(RxTest, cutout_start_reports_channel_offsets) {
+  auto const tcs{RandomInterval<uint32_t>(TCSMin, TCSMax)};
+  auto packet{make_function_group_f4_f0_packet(_addrs.primary, 10u)};
+  Receive(packet)->LeaveCutout()->Execute()->Receive(packet);
+  ASSERT_TRUE(_mock.packetEnd());
+
+  // Offsets are relative to the cutout start edge
+  EXPECT_CALL(_mock, cutoutStart(TTS1 - tcs, TTS2 - tcs));
+  _mock.receive(tcs);
+  EXPECT_TRUE(_mock.packetEnd());
+
+  // Channels can still be started
+  EXPECT_CALL(_mock, transmitBiDi(_)).Times(AtLeast(1));
+  BiDi();
+
+  // Cutout end
+  _mock.receive(TCE - tcs);
+  EXPECT_FALSE(_mock.packetEnd());
+}
+
+TEST_F(RxTest, no_cutout_start_outside_packet_end) {
+  EXPECT_CALL(_mock, cutoutStart(_, _)).Times(0);
+  EXPECT_CALL(_mock, function(_, _, _)).Times(0);
+
+  // Cutout start timing in the middle of a packet resets the receiver
+  auto const timings{dcc::tx::packet2timings(
+    make_function_group_f4_f0_packet(_addrs.primary, 10u))};
+  for (auto i{0uz}; i < size(timings); ++i) {
+    _mock.receive(timings[i]);
+    if (i == size(timings) / 2uz) _mock.receive(TCS);
+  }
+  EXPECT_FALSE(_mock.packetEnd());
+  Execute();
+}
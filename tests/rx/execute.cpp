@@ -0,0 +1,29 @@
+#include "rx_test.hpp"
+
+TEST_F(RxTest, execute_up_to_n_commands) {
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, 0u)};
+  for (auto i{0uz}; i < 10uz; ++i) Receive(packet)->LeaveCutout();
+
+  EXPECT_CALL(_mock, function(_addrs.primary.value, _, _)).Times(10);
+  EXPECT_EQ(_mock.execute(4uz), 4uz);
+  EXPECT_EQ(_mock.execute(100uz), 6uz);
+  EXPECT_EQ(_mock.execute(100uz), 0uz);
+}
+
+TEST_F(RxTest, execute_within_budget) {
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, 0u)};
+  for (auto i{0uz}; i < 10uz; ++i) Receive(packet)->LeaveCutout();
+
+  // Budget gets checked before each command
+  auto budget{3};
+  EXPECT_EQ(_mock.execute([&budget] { return budget-- > 0; }), 3uz);
+  EXPECT_EQ(_mock.execute([] { return true; }), 7uz);
+}
+
+TEST_F(RxTest, execute_n_commands_refused_at_packet_end) {
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u));
+  ASSERT_TRUE(_mock.packetEnd());
+  EXPECT_EQ(_mock.execute(100uz), 0uz);
+  LeaveCutout();
+  EXPECT_EQ(_mock.execute(100uz), 1uz);
+}
@@ -0,0 +1,47 @@
+#include "rx_test.hpp"
+
+namespace {
+
+constexpr dcc::rx::Config function_only_cfg{
+  .features = {.bidi = false, .pom = false, .service_mode = false}};
+
+} // namespace
+
+using FeaturesTest = BasicRxTest<function_only_cfg>;
+
+TEST_F(FeaturesTest, stripped_features_shrink_decoder) {
+  EXPECT_LT(
+    sizeof(dcc::rx::CrtpBase<BasicRxMock<function_only_cfg>,
+                             function_only_cfg>),
+    sizeof(dcc::rx::CrtpBase<BasicRxMock<>, dcc::rx::Config{}>));
+}
+
+TEST_F(FeaturesTest, function_only) {
+  // Functions still get executed
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, 0b1u));
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, 1u));
+
+  // BiDi stays silent
+  EXPECT_CALL(_mock, transmitBiDi(_)).Times(0);
+  BiDi()->LeaveCutout();
+  EXPECT_TRUE(_mock.execute());
+
+  // Reset packets don't enter service mode
+  EXPECT_CALL(_mock, serviceModeHook(_)).Times(0);
+  Receive(dcc::make_reset_packet())->LeaveCutout()->Execute();
+  EXPECT_FALSE(_mock.serviceMode());
+
+  // PoM gets ignored
+  EXPECT_CALL(_mock,
+              writeCv(Matcher<uint32_t>(_),
+                      Matcher<uint8_t>(_),
+                      Matcher<std::function<void(uint8_t)>>(_)))
+    .Times(0);
+  EXPECT_CALL(_mock, writeCv(Matcher<uint32_t>(_), Matcher<uint8_t>(_)))
+    .Times(0);
+  for (auto i{0uz}; i < 2uz; ++i) {
+    Receive(dcc::make_cv_access_long_write_packet(_addrs.primary, 42u, 7u))
+      ->LeaveCutout();
+    EXPECT_FALSE(_mock.execute());
+  }
+}
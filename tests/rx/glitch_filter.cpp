@@ -0,0 +1,64 @@
+#include "rx_test.hpp"
+
+namespace {
+
+constexpr dcc::rx::Config glitch_filter_cfg{.glitch_filter =
+                                              dcc::rx::Bit1Min};
+
+// Split one random half-bit of each packet with a short spike
+template<typename Mock>
+size_t ReceiveNoisyPackets(Mock& mock, dcc::Packet const& packet, size_t n) {
+  std::mt19937 gen{42u};
+  auto const timings{dcc::tx::packet2timings(packet)};
+  std::uniform_int_distribution<size_t> pos_dis{0uz, size(timings) - 1uz};
+  std::uniform_int_distribution<uint32_t> glitch_dis{1u, 5u};
+
+  size_t count{};
+  ON_CALL(mock, function(_, _, _)).WillByDefault([&count] { ++count; });
+
+  for (auto i{0uz}; i < n; ++i) {
+    auto const pos{pos_dis(gen)};
+    for (auto j{0uz}; j < size(timings); ++j) {
+      auto const t{timings[j]};
+      if (j != pos) {
+        mock.receive(t);
+        continue;
+      }
+      auto const glitch{glitch_dis(gen)};
+      std::uniform_int_distribution<uint32_t> first_dis{1u, t - glitch - 1u};
+      auto const first{first_dis(gen)};
+      mock.receive(first);
+      mock.receive(glitch);
+      mock.receive(t - first - glitch);
+    }
+    mock.receive(dcc::rx::Timing::Bit1);
+    mock.execute();
+  }
+
+  return count;
+}
+
+} // namespace
+
+using GlitchFilterTest = BasicRxTest<glitch_filter_cfg>;
+
+TEST_F(GlitchFilterTest, does_not_change_clean_signal) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state));
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, state));
+  EXPECT_TRUE(_mock.packetEnd());
+  LeaveCutout()->Execute();
+}
+
+TEST_F(GlitchFilterTest, increases_packet_acceptance_under_noise) {
+  NiceMock<RxMock> unfiltered;
+  InitMock(unfiltered);
+
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, 0u)};
+  static constexpr auto n{1000uz};
+  auto const unfiltered_count{ReceiveNoisyPackets(unfiltered, packet, n)};
+  auto const filtered_count{ReceiveNoisyPackets(_mock, packet, n)};
+  RecordProperty("unfiltered_acceptance", static_cast<int>(unfiltered_count));
+  RecordProperty("filtered_acceptance", static_cast<int>(filtered_count));
+  EXPECT_GT(filtered_count, unfiltered_count);
+}
@@ -0,0 +1,82 @@
+#include "rx_test.hpp"
+
+using dcc::Instruction;
+
+using HandlerModeTest = BasicRxTest<dcc::rx::Config{
+  .statistics = true,
+  .handler_mode = dcc::rx::instruction_mask<Instruction::AdvancedOperations,
+                                            Instruction::SpeedDirection>}>;
+
+TEST_F(HandlerModeTest, executes_speed_immediately) {
+  // Executed at packet end without entering deque
+  EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::scale_speed<126>(41)));
+  Receive(make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 42u))
+    ->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().packets_accepted, 0u);
+  EXPECT_FALSE(_mock.execute());
+}
+
+TEST_F(HandlerModeTest, leaves_other_instructions_to_thread_mode) {
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u))->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().packets_accepted, 1u);
+  EXPECT_CALL(_mock, function(_addrs.primary.value, _, _));
+  EXPECT_TRUE(_mock.execute());
+}
+
+TEST_F(HandlerModeTest, ignores_foreign_address) {
+  EXPECT_CALL(_mock, speed(_, _)).Times(0);
+  Receive(dcc::make_advanced_operations_speed_packet(42u, 0x81u))
+    ->LeaveCutout();
+  while (_mock.execute());
+}
+
+TEST_F(HandlerModeTest, resets_own_equal_packets_count) {
+  // Don't write any CV which might trigger config (e.g. 1, 28, ...)!
+  auto cv_addr{RandomInterval(30u, smath::pow(2u, 10u) - 1u)};
+  auto byte{RandomInterval<uint8_t>(0u, 255u)};
+  auto packet{
+    make_cv_access_long_write_packet(_addrs.primary, cv_addr, byte)};
+
+  // Own packet in between CV access packets
+  EXPECT_CALL(_mock,
+              writeCv(Matcher<uint32_t>(cv_addr),
+                      Matcher<uint8_t>(byte),
+                      Matcher<std::function<void(uint8_t)>>(_)))
+    .Times(0);
+  ReceiveAndExecute(packet);
+  Receive(make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 42u))
+    ->LeaveCutout();
+  ReceiveAndExecute(packet);
+}
+
+TEST_F(HandlerModeTest, waits_for_queued_reset) {
+  EXPECT_CALL(_mock, speed(_, _)).Times(0);
+  Receive(dcc::make_reset_packet())->LeaveCutout();
+  Receive(make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 42u))
+    ->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().packets_accepted, 2u);
+}
+
+using HandlerModeSpeedDirectionTest = BasicRxTest<dcc::rx::Config{
+  .statistics = true,
+  .handler_mode = dcc::rx::instruction_mask<Instruction::SpeedDirection>}>;
+
+TEST_F(HandlerModeSpeedDirectionTest, doesnt_overtake_queued_speed) {
+  // 126 speed steps are executed in thread mode
+  Receive(make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 42u))
+    ->LeaveCutout();
+  Receive(make_speed_and_direction_packet(_addrs.primary, 0b11'0000u))
+    ->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().packets_accepted, 2u);
+
+  InSequence s;
+  EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::scale_speed<126>(41)));
+  EXPECT_CALL(_mock, speed(_addrs.primary.value, _));
+  while (_mock.execute());
+
+  // Executed at packet end once deque is empty
+  EXPECT_CALL(_mock, speed(_addrs.primary.value, _));
+  Receive(make_speed_and_direction_packet(_addrs.primary, 0b11'0000u))
+    ->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().packets_accepted, 2u);
+}
@@ -0,0 +1,35 @@
+#include "rx_test.hpp"
+#include <numeric>
+
+using HistogramTest = BasicRxTest<dcc::rx::Config{.histogram = true}>;
+
+TEST_F(HistogramTest, half_bit_timings) {
+  auto const timings{dcc::tx::packet2timings(
+    make_function_group_f4_f0_packet(_addrs.primary, 0b1'0101u))};
+  for (auto const t : timings) _mock.receive(t);
+  _mock.receive(dcc::rx::Bit0MaxAnalog);
+
+  auto const ones{std::ranges::count(timings, dcc::rx::Bit1)};
+  auto const zeros{std::ranges::count(timings, dcc::rx::Bit0)};
+  auto histogram{_mock.histogram()};
+  EXPECT_EQ(histogram.bins[dcc::rx::Bit1 / dcc::rx::Histogram::bin_width],
+            ones);
+  EXPECT_EQ(histogram.bins[dcc::rx::Bit0 / dcc::rx::Histogram::bin_width],
+            zeros);
+  EXPECT_EQ(histogram.bins.back(), 1u);
+  EXPECT_EQ(std::accumulate(cbegin(histogram.bins), cend(histogram.bins), 0uz),
+            size(timings) + 1uz);
+
+  // Snapshot resets histogram
+  histogram = _mock.histogram();
+  EXPECT_TRUE(std::ranges::all_of(histogram.bins,
+                                  [](uint32_t bin) { return !bin; }));
+
+  // Switching buffers doesn't lose any times
+  _mock.receive(dcc::rx::Bit1);
+  histogram = _mock.histogram();
+  EXPECT_EQ(histogram.bins[dcc::rx::Bit1 / dcc::rx::Histogram::bin_width], 1u);
+  _mock.receive(dcc::rx::Bit1);
+  histogram = _mock.histogram();
+  EXPECT_EQ(histogram.bins[dcc::rx::Bit1 / dcc::rx::Histogram::bin_width], 1u);
+}
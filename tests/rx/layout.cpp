@@ -0,0 +1,24 @@
+#include "rx_test.hpp"
+
+namespace {
+
+template<dcc::rx::Config Cfg>
+consteval bool HotStateFirst() {
+  constexpr auto layout{BasicRxMock<Cfg>::layout()};
+  return !layout.hot_first && layout.hot_last <= layout.cold_first &&
+         alignof(BasicRxMock<Cfg>) >= Cfg.cache_line;
+}
+
+} // namespace
+
+static_assert(HotStateFirst<dcc::rx::Config{}>());
+static_assert(HotStateFirst<dcc::rx::Config{.inputs = 2uz,
+                                            .histogram = true,
+                                            .statistics = true,
+                                            .address_filter = true,
+                                            .priority_estop = true,
+                                            .cache_line = 64uz}>());
+
+// Natural alignment
+static_assert(alignof(BasicRxMock<dcc::rx::Config{.cache_line = 0uz}>) <
+              alignof(RxMock));
@@ -144,3 +144,20 @@ TEST_F(
     make_logon_enable_packet(dcc::AddressGroup::Now, _cid + 1u, _sid + 1u));
   BiDi();
 }
+
+// Logon packets with invalid CRC are ignored
+TEST_F(RxTest, logon_select_with_invalid_crc) {
+  EXPECT_CALL(_mock, transmitBiDi(_)).Times(2);
+
+  // Enable
+  Receive(make_logon_enable_packet(
+    dcc::AddressGroup::Now, _cid + 1u, RandomInterval<uint8_t>(0u, 255u)));
+  BiDi();
+
+  // Select with invalid CRC but valid checksum
+  auto packet{dcc::make_logon_select_packet(DCC_MANUFACTURER_ID, _did)};
+  packet[size(packet) - 2uz] ^= 0x01u;
+  packet.back() ^= 0x01u;
+  Receive(packet);
+  BiDi();
+}
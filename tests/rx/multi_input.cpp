@@ -0,0 +1,51 @@
+#include "rx_test.hpp"
+
+struct MultiInputTest : BasicRxTest<dcc::rx::Config{.inputs = 2uz}> {
+  void ReceiveOnInput(dcc::Packet const& packet, size_t i) {
+    for (auto const t : dcc::tx::packet2timings(packet)) _mock.receive(t, i);
+  }
+
+  void LeaveCutoutOnAllInputs() {
+    for (auto i{0uz}; i < 2uz; ++i) _mock.receive(dcc::rx::Bit1, i);
+  }
+};
+
+TEST_F(MultiInputTest, executes_identical_packets_once) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, state)};
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state)).Times(2);
+
+  // Each repetition is seen by both inputs
+  for (auto i{0uz}; i < 2uz; ++i) {
+    ReceiveOnInput(packet, 0uz);
+    EXPECT_TRUE(_mock.packetEnd());
+    ReceiveOnInput(packet, 1uz);
+    EXPECT_TRUE(_mock.packetEnd());
+    LeaveCutoutOnAllInputs();
+    while (_mock.execute());
+  }
+}
+
+TEST_F(MultiInputTest, repetitions_on_one_input_pass) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, state)};
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state)).Times(2);
+
+  // Second input misses the first repetition
+  ReceiveOnInput(packet, 0uz);
+  ReceiveOnInput(packet, 0uz);
+  ReceiveOnInput(packet, 1uz);
+  LeaveCutoutOnAllInputs();
+  while (_mock.execute());
+}
+
+TEST_F(MultiInputTest, executes_different_packets) {
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, 0b0'0001u));
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, 0b0'0010u));
+  ReceiveOnInput(
+    make_function_group_f4_f0_packet(_addrs.primary, 0b0'0001u), 0uz);
+  ReceiveOnInput(
+    make_function_group_f4_f0_packet(_addrs.primary, 0b0'0010u), 1uz);
+  LeaveCutoutOnAllInputs();
+  while (_mock.execute());
+}
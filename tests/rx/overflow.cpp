@@ -0,0 +1,59 @@
+#include "rx_test.hpp"
+
+template<dcc::rx::Overflow Policy>
+using OverflowTest =
+  BasicRxTest<dcc::rx::Config{.statistics = true, .overflow = Policy}>;
+
+using OverflowDropOldestTest = OverflowTest<dcc::rx::Overflow::DropOldest>;
+using OverflowReplaceTest = OverflowTest<dcc::rx::Overflow::Replace>;
+
+TEST_F(OverflowDropOldestTest, drops_oldest) {
+  // Packets 2 and 3 get dropped
+  for (auto i{1u}; i <= DCC_RX_DEQUE_SIZE + 2u; ++i)
+    Receive(make_advanced_operations_speed_packet(_addrs.primary, 0x80u | i))
+      ->LeaveCutout();
+  auto const statistics{_mock.statistics()};
+  EXPECT_EQ(statistics.deque_drops, 2u);
+  EXPECT_EQ(statistics.deque_overflows, 0u);
+
+  {
+    InSequence seq;
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::EStop));
+    for (auto i{4u}; i <= DCC_RX_DEQUE_SIZE + 2u; ++i)
+      EXPECT_CALL(_mock,
+                  speed(_addrs.primary.value, dcc::scale_speed<126>(i - 1)));
+  }
+  while (_mock.execute());
+}
+
+TEST_F(OverflowReplaceTest, replaces_same_command) {
+  auto const speed10{
+    make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 10u)};
+  auto const speed20{
+    make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 20u)};
+
+  // Fill deque with a single speed packet between function packets
+  Receive(make_function_group_f8_f5_packet(_addrs.primary, 0u))->LeaveCutout();
+  Receive(speed10)->LeaveCutout();
+  for (auto i{2uz}; i < DCC_RX_DEQUE_SIZE; ++i)
+    Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u))
+      ->LeaveCutout();
+
+  // Newest speed supersedes queued one
+  Receive(speed20)->LeaveCutout();
+  auto statistics{_mock.statistics()};
+  EXPECT_EQ(statistics.deque_replacements, 1u);
+  EXPECT_EQ(statistics.deque_drops, 0u);
+
+  // Different command drops oldest
+  Receive(make_function_group_f12_f9_packet(_addrs.primary, 0u))
+    ->LeaveCutout();
+  statistics = _mock.statistics();
+  EXPECT_EQ(statistics.deque_replacements, 1u);
+  EXPECT_EQ(statistics.deque_drops, 1u);
+
+  EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::scale_speed<126>(9)))
+    .Times(0);
+  EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::scale_speed<126>(19)));
+  while (_mock.execute());
+}
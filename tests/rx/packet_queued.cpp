@@ -0,0 +1,29 @@
+#include "rx_test.hpp"
+
+TEST_F(RxTest, packet_queued_after_packet_end) {
+  auto packet{make_function_group_f4_f0_packet(_addrs.primary, 10u)};
+
+  // Not during packet end, execute would refuse anyway
+  EXPECT_CALL(_mock, packetQueued()).Times(0);
+  Receive(packet);
+  ASSERT_TRUE(_mock.packetEnd());
+  Mock::VerifyAndClearExpectations(&_mock);
+
+  EXPECT_CALL(_mock, packetQueued());
+  LeaveCutout();
+  Mock::VerifyAndClearExpectations(&_mock);
+
+  // Only once per packet
+  EXPECT_CALL(_mock, packetQueued()).Times(0);
+  Execute();
+  for (auto i{0uz}; i < DCC_RX_MIN_PREAMBLE_BITS; ++i)
+    _mock.receive(dcc::rx::Bit1);
+}
+
+TEST_F(RxTest, no_packet_queued_for_invalid_packet) {
+  auto packet{make_function_group_f4_f0_packet(_addrs.primary, 10u)};
+  packet.back() = static_cast<uint8_t>(~packet.back());
+
+  EXPECT_CALL(_mock, packetQueued()).Times(0);
+  Receive(packet)->LeaveCutout();
+}
@@ -0,0 +1,92 @@
+#include "rx_test.hpp"
+
+using PriorityEstopTest =
+  BasicRxTest<dcc::rx::Config{.priority_estop = true}>;
+
+TEST_F(PriorityEstopTest, executes_first) {
+  auto const speed42{
+    make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 42u)};
+  auto const estop{
+    make_advanced_operations_speed_packet(_addrs.primary, 0x81u)};
+  auto const speed21{
+    make_advanced_operations_speed_packet(_addrs.primary, 0x80u | 21u)};
+
+  // Fill deque with speed and function packets
+  for (auto i{0uz}; i < DCC_RX_DEQUE_SIZE / 2uz - 1uz; ++i) {
+    Receive(speed42)->LeaveCutout();
+    Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u))
+      ->LeaveCutout();
+  }
+  Receive(estop)->LeaveCutout();
+  Receive(speed21)->LeaveCutout();
+
+  {
+    InSequence seq;
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::EStop));
+    // Outdated speed packets get skipped, functions don't
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::scale_speed<126>(41)))
+      .Times(0);
+    EXPECT_CALL(_mock, function(_addrs.primary.value, _, _))
+      .Times(DCC_RX_DEQUE_SIZE / 2uz - 1uz);
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::EStop));
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::scale_speed<126>(20)));
+  }
+  // Skipped packets aren't accepted, so execute doesn't return true
+  for (auto i{0uz}; i < DCC_RX_DEQUE_SIZE + 1uz; ++i) _mock.execute();
+}
+
+TEST_F(PriorityEstopTest, broadcast_estop) {
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u))->LeaveCutout();
+  Receive(dcc::make_speed_and_direction_packet(0u, 0b00'0001u))->LeaveCutout();
+
+  {
+    InSequence seq;
+    EXPECT_CALL(_mock, speed(0u, dcc::EStop));
+    EXPECT_CALL(_mock, function(_addrs.primary.value, _, _));
+    EXPECT_CALL(_mock, speed(0u, dcc::EStop));
+  }
+  while (_mock.execute());
+}
+
+TEST_F(PriorityEstopTest, ignores_foreign_address) {
+  EXPECT_CALL(_mock, speed(_, _)).Times(0);
+  Receive(dcc::make_advanced_operations_speed_packet(42u, 0x81u))
+    ->LeaveCutout();
+  while (_mock.execute());
+}
+
+TEST_F(PriorityEstopTest, keeps_speed_of_other_address) {
+  _cvs[19uz - 1uz] = static_cast<uint8_t>(_addrs.consist);
+  SetUp();
+
+  Receive(make_advanced_operations_speed_packet(_addrs.consist, 0x80u | 42u))
+    ->LeaveCutout();
+  Receive(make_advanced_operations_speed_packet(_addrs.primary, 0x81u))
+    ->LeaveCutout();
+
+  {
+    InSequence seq;
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::EStop));
+    EXPECT_CALL(_mock, speed(_addrs.consist.value, dcc::scale_speed<126>(41)));
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::EStop));
+  }
+  while (_mock.execute());
+}
+
+TEST_F(PriorityEstopTest, keeps_functions_of_outdated_packets) {
+  Receive(make_advanced_operations_speed_direction_and_functions_packet(
+            _addrs.primary, 0x80u | 42u, 0b0000'1010u))
+    ->LeaveCutout();
+  Receive(make_advanced_operations_speed_packet(_addrs.primary, 0x81u))
+    ->LeaveCutout();
+
+  {
+    InSequence seq;
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::EStop));
+    EXPECT_CALL(_mock, function(_addrs.primary.value, 0xFFu, 0b0000'1010u));
+    EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::EStop));
+  }
+  EXPECT_CALL(_mock, speed(_addrs.primary.value, dcc::scale_speed<126>(41)))
+    .Times(0);
+  while (_mock.execute());
+}
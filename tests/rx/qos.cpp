@@ -0,0 +1,44 @@
+#include "rx_test.hpp"
+
+TEST(QosTest, no_packets_lost) {
+  dcc::rx::Qos<16uz> qos;
+  for (auto i{0uz}; i < 100uz; ++i) qos.update(false);
+  EXPECT_EQ(qos, 0u);
+}
+
+TEST(QosTest, all_packets_lost) {
+  dcc::rx::Qos<16uz> qos;
+  for (auto i{0uz}; i < 200uz; ++i) qos.update(true);
+  EXPECT_EQ(qos, 100u);
+}
+
+TEST(QosTest, every_second_packet_lost) {
+  dcc::rx::Qos<16uz> qos;
+  for (auto i{0uz}; i < 200uz; ++i) qos.update(i % 2uz);
+  EXPECT_NEAR(qos, 50, 3);
+}
+
+TEST(QosTest, step_response_within_window) {
+  dcc::rx::Qos<16uz> qos;
+  for (auto i{0uz}; i < 16uz; ++i) qos.update(true);
+  // 1 - (1 - 1/16)^16
+  EXPECT_NEAR(qos, 64, 1);
+  for (auto i{0uz}; i < 16uz; ++i) qos.update(false);
+  EXPECT_NEAR(qos, 23, 1);
+}
+
+TEST_F(RxTest, qos_follows_lost_packets) {
+  auto packet{make_function_group_f4_f0_packet(_addrs.primary, 10u)};
+  auto invalid_packet{packet};
+  invalid_packet.back() = static_cast<uint8_t>(~invalid_packet.back());
+
+  // Lose every packet
+  for (auto i{0uz}; i < 100uz; ++i) Receive(invalid_packet);
+  Receive(packet);
+  EXPECT_CALL(
+    _mock,
+    transmitBiDi(DatagramMatcher(dcc::bidi::encode_datagram(
+      dcc::bidi::make_datagram<dcc::bidi::Bits::_18>(7u, 94u << 6u | 7u)))));
+  _mock.datagram();
+  _mock.biDiChannel2();
+}
@@ -1,4 +1,24 @@
 #include "rx_test.hpp"
+#include <vector>
+
+namespace {
+
+// Pack packet into words (MSB first) with trailing preamble bits
+std::vector<uint32_t> Packet2Bits(dcc::Packet const& packet,
+                                  size_t preamble_bits) {
+  std::vector<bool> bits(preamble_bits, true);
+  for (auto i{0uz}; i < size(packet); ++i) {
+    bits.push_back(false);
+    for (auto j{CHAR_BIT}; j-- > 0;) bits.push_back(packet[i] & (1u << j));
+  }
+  bits.insert(cend(bits), 32uz, true);
+  std::vector<uint32_t> words((size(bits) + 31uz) / 32uz, ~0u);
+  for (auto i{0uz}; i < size(bits); ++i)
+    if (!bits[i]) words[i / 32uz] &= ~(1u << (31uz - i % 32uz));
+  return words;
+}
+
+} // namespace
 
 TEST_F(RxTest, invalid_bit_resets_internal_state_machine) {
   auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
@@ -16,3 +36,79 @@ TEST_F(RxTest, invalid_bit_resets_internal_state_machine) {
 
   Execute();
 }
+
+TEST_F(RxTest, receive_block_of_timings) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state));
+
+  // Receive whole packet at once, e.g. from a DMA buffer
+  auto const timings{dcc::tx::packet2timings(
+    make_function_group_f4_f0_packet(_addrs.primary, state))};
+  std::vector<uint32_t> const block(cbegin(timings), cend(timings));
+  _mock.receive(block);
+  EXPECT_TRUE(_mock.packetEnd());
+
+  LeaveCutout();
+  EXPECT_FALSE(_mock.packetEnd());
+  Execute();
+}
+
+TEST_F(RxTest, receive_16_bit_timestamps_with_wraparound) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state));
+
+  // Convert timings into timestamps of a free-running 16 bit counter which
+  // overflows in the middle of the packet
+  auto const timings{dcc::tx::packet2timings(
+    make_function_group_f4_f0_packet(_addrs.primary, state))};
+  std::vector<uint16_t> timestamps{};
+  uint16_t timestamp{0xFF00u};
+  for (auto const t : timings)
+    timestamps.push_back(timestamp = static_cast<uint16_t>(timestamp + t));
+  _mock.receiveTimestamp(timestamps);
+
+  LeaveCutout()->Execute();
+}
+
+TEST_F(RxTest, receive_24_bit_timestamps_with_wraparound) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state));
+
+  auto const timings{dcc::tx::packet2timings(
+    make_function_group_f4_f0_packet(_addrs.primary, state))};
+  uint32_t timestamp{0xFF'FF00u};
+  for (auto const t : timings)
+    _mock.receiveTimestamp<24uz>(timestamp = (timestamp + t) & 0xFF'FFFFu);
+
+  LeaveCutout()->Execute();
+}
+
+TEST_F(RxTest, receive_packed_bits) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, state)};
+
+  // Vary preamble length to hit every alignment of bytes in words
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state))
+    .Times(32);
+  for (auto i{0uz}; i < 32uz; ++i) {
+    auto const words{Packet2Bits(packet, DCC_RX_MIN_PREAMBLE_BITS + i)};
+    // Feed single words to split packets across calls
+    for (auto const& word : words) _mock.receiveBits({&word, 1uz});
+    _mock.execute();
+  }
+}
+
+TEST_F(RxTest, receive_packed_bits_rejects_invalid_packets) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  auto packet{make_function_group_f4_f0_packet(_addrs.primary, state)};
+  EXPECT_CALL(_mock, function(_, _, _)).Times(0);
+
+  // Preamble too short
+  _mock.receiveBits(Packet2Bits(packet, DCC_RX_MIN_PREAMBLE_BITS - 1uz));
+  _mock.execute();
+
+  // Invalid checksum
+  packet.back() = static_cast<uint8_t>(~packet.back());
+  _mock.receiveBits(Packet2Bits(packet, DCC_RX_MIN_PREAMBLE_BITS));
+  _mock.execute();
+}
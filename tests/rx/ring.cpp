@@ -0,0 +1,65 @@
+#include <thread>
+#include "rx_test.hpp"
+
+TEST(RingTest, commit_or_discard_next_slot) {
+  dcc::rx::Ring<int, 3uz> ring;
+  EXPECT_TRUE(empty(ring));
+
+  // Uncommitted slots aren't visible
+  ring.next() = 42;
+  EXPECT_TRUE(empty(ring));
+  ring.next() = 43;
+  ring.commit();
+  EXPECT_EQ(size(ring), 1uz);
+  EXPECT_EQ(ring.front(), 43);
+}
+
+TEST(RingTest, next_slot_is_valid_when_full) {
+  dcc::rx::Ring<int, 3uz> ring;
+  for (auto i{0}; i < 3; ++i) ring.push_back(i);
+  EXPECT_TRUE(full(ring));
+
+  // Writing the next slot doesn't touch any element
+  ring.next() = 42;
+  for (auto i{0}; i < 3; ++i) {
+    EXPECT_EQ(ring.front(), i);
+    ring.pop_front();
+  }
+  EXPECT_TRUE(empty(ring));
+}
+
+TEST(RingTest, wraparound) {
+  dcc::rx::Ring<int, 3uz> ring;
+  for (auto i{0}; i < 10; ++i) {
+    ring.push_back(i);
+    ring.push_back(i + 1);
+    EXPECT_EQ(size(ring), 2uz);
+    EXPECT_EQ(ring.front(), i);
+    EXPECT_EQ(ring.back(), i + 1);
+    ring.pop_front();
+    EXPECT_EQ(ring.front(), i + 1);
+    ring.pop_front();
+  }
+  EXPECT_TRUE(empty(ring));
+}
+
+TEST(RingTest, producer_and_consumer_on_different_threads) {
+  dcc::rx::Ring<std::array<uint32_t, 4uz>, 7uz, true> ring;
+  constexpr uint32_t count{100'000u};
+
+  std::jthread producer{[&ring] {
+    for (auto i{0u}; i < count;) {
+      if (full(ring)) continue;
+      ring.next().fill(i++);
+      ring.commit();
+    }
+  }};
+
+  // Elements arrive complete and in order
+  for (auto i{0u}; i < count;) {
+    if (empty(ring)) continue;
+    EXPECT_EQ(ring.front(), (std::array<uint32_t, 4uz>{i, i, i, i}));
+    ring.pop_front();
+    ++i;
+  }
+}
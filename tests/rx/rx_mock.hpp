@@ -4,7 +4,8 @@
 #include <gtest/gtest.h>
 #include <dcc/dcc.hpp>
 
-struct RxMock : dcc::rx::CrtpBase<RxMock> {
+template<dcc::rx::Config Cfg = dcc::rx::Config{}>
+struct BasicRxMock : dcc::rx::CrtpBase<BasicRxMock<Cfg>, Cfg> {
   MOCK_METHOD(void, direction, (uint32_t, int32_t));
   MOCK_METHOD(void, speed, (uint32_t, int32_t));
   MOCK_METHOD(void, function, (uint32_t, uint32_t, uint32_t));
@@ -18,4 +19,8 @@ struct RxMock : dcc::rx::CrtpBase<RxMock> {
   MOCK_METHOD(void, readCv, (uint32_t, uint8_t, std::function<void(uint8_t)>));
   MOCK_METHOD(void, writeCv, (uint32_t, uint8_t, std::function<void(uint8_t)>));
   MOCK_METHOD(void, transmitBiDi, (std::span<uint8_t const>));
+  MOCK_METHOD(void, cutoutStart, (uint32_t, uint32_t));
+  MOCK_METHOD(void, packetQueued, ());
 };
+
+using RxMock = BasicRxMock<>;
@@ -1,60 +1,12 @@
 #pragma once
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <random>
 #include "rx_mock.hpp"
 
 using namespace ::testing;
 
-// Receive test fixture
-struct RxTest : ::testing::Test {
-  RxTest();
-  virtual ~RxTest();
-
-  void SetUp() override;
-
-  RxTest* Receive(dcc::Packet const& packet);
-  RxTest* BiDiChannel1();
-  RxTest* BiDiChannel2();
-  RxTest* BiDi();
-  RxTest* LeaveCutout();
-  RxTest* Execute();
-
-  void EnterServiceMode();
-
-  void Logon();
-
-  dcc::Packet TinkerWithPacketLength(dcc::Packet packet) const;
-
-  template<std::unsigned_integral T>
-  static T RandomInterval(T min, T max) {
-    std::mt19937 gen{std::random_device{}()};
-    std::uniform_int_distribution<T> dis{min, max};
-    return dis(gen);
-  }
-
-  /// \todo this needs to go
-  void ReceiveAndExecute(dcc::Packet const& packet) {
-    Receive(packet)->LeaveCutout()->Execute();
-  }
-
-  /// \todo this needs to go
-  void ReceiveAndExecuteTwice(dcc::Packet const& packet) {
-    ReceiveAndExecute(packet);
-    ReceiveAndExecute(packet);
-  }
-
-  NiceMock<RxMock> _mock;
-  dcc::Addresses _addrs{
-    .primary = {.value = 3u, .type = dcc::Address::BasicLoco},
-    .consist = {.value = 4u, .type = dcc::Address::BasicLoco},
-    .logon = {.value = 1000u, .type = dcc::Address::ExtendedLoco}};
-  std::array<uint8_t, smath::pow(2uz, 16uz)> _cvs{};
-  uint32_t _did{0xAABBCCDDu};
-  uint16_t _cid{0xABCDu};
-  uint8_t _sid{0x2Au};
-};
-
 MATCHER_P(DatagramMatcher, datagram, "") {
   return std::equal(cbegin(datagram), cend(datagram), cbegin(arg));
 }
@@ -97,3 +49,152 @@ MATCHER_P(DatagramMatcher, datagram, "") {
     .WillOnce(Return(_cvs[DCC_RX_LOGON_SID_CV_ADDRESS]))                       \
     .WillOnce(Return(_cvs[DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 0u]))              \
     .WillOnce(Return(_cvs[DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 1u]))
+
+// Receive test fixture
+template<dcc::rx::Config Cfg = dcc::rx::Config{}>
+struct BasicRxTest : ::testing::Test {
+  BasicRxTest() {
+    _cvs[29uz - 1uz] = 0b1010u; // Decoder configuration
+    _cvs[1uz - 1uz] = static_cast<uint8_t>(_addrs.primary); // Primary address
+    _cvs[19uz - 1uz] = 0u;           // Consist address low byte
+    _cvs[20uz - 1uz] = 0u;           // Consist address high byte
+    _cvs[15uz - 1uz] = 0u;           // Lock
+    _cvs[16uz - 1uz] = 0u;           // Lock compare
+    _cvs[28uz - 1uz] = 0b1000'0011u; // RailCom
+
+    // Decoder ID
+    _cvs[DCC_RX_LOGON_DID_CV_ADDRESS + 0uz] = static_cast<uint8_t>(_did >> 24u);
+    _cvs[DCC_RX_LOGON_DID_CV_ADDRESS + 1uz] = static_cast<uint8_t>(_did >> 16u);
+    _cvs[DCC_RX_LOGON_DID_CV_ADDRESS + 2uz] = static_cast<uint8_t>(_did >> 8u);
+    _cvs[DCC_RX_LOGON_DID_CV_ADDRESS + 3uz] = static_cast<uint8_t>(_did >> 0u);
+
+    // CID
+    _cvs[DCC_RX_LOGON_CID_CV_ADDRESS + 0uz] = static_cast<uint8_t>(_cid >> 8u);
+    _cvs[DCC_RX_LOGON_CID_CV_ADDRESS + 1uz] = static_cast<uint8_t>(_cid >> 0u);
+
+    // SID
+    _cvs[DCC_RX_LOGON_SID_CV_ADDRESS] = _sid;
+
+    // Logon address
+    _cvs[DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 0uz] =
+      static_cast<uint8_t>(0b1100'0000u | _addrs.logon >> 8u);
+    _cvs[DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 1uz] =
+      static_cast<uint8_t>(_addrs.logon >> 0u);
+  }
+
+  virtual ~BasicRxTest() {}
+
+  void SetUp() override {
+    // Decoders without BiDi or logon don't read the whole sequence
+    if constexpr (!Cfg.features.bidi || !Cfg.features.logon) InitMock(_mock);
+    // Extended address
+    else if (_cvs[29uz - 1uz] & ztl::mask<5u>) {
+      /// \note
+      /// This is weird... but not having the EXPECT_CALL inside a lambda makes
+      /// GCC 14.2.1 (and 15.2.1) hang.
+      std::invoke([this] {
+        EXTENDED_ADDRESS_EXPECT_CALL_READ_CV_INIT_SEQUENCE();
+        _mock.init();
+      });
+    }
+    // Basic address
+    else {
+      std::invoke([this] {
+        BASIC_ADDRESS_EXPECT_CALL_READ_CV_INIT_SEQUENCE();
+        _mock.init();
+      });
+    }
+  }
+
+  BasicRxTest* Receive(dcc::Packet const& packet) {
+    auto timings{dcc::tx::packet2timings(packet)};
+    std::ranges::for_each_n(cbegin(timings),
+                            size(timings),
+                            [this](uint32_t time) { _mock.receive(time); });
+    return this;
+  }
+
+  BasicRxTest* BiDiChannel1() {
+    _mock.biDiChannel1();
+    return this;
+  }
+
+  BasicRxTest* BiDiChannel2() {
+    _mock.biDiChannel2();
+    return this;
+  }
+
+  BasicRxTest* BiDi() { return BiDiChannel1()->BiDiChannel2(); }
+
+  BasicRxTest* LeaveCutout() {
+    // Receive additional preamble bit before calling execute to avoid being
+    // inside a cutout and getting execution blocked!
+    _mock.receive(dcc::rx::Timing::Bit1);
+    return this;
+  }
+
+  BasicRxTest* Execute() {
+    _mock.execute();
+    return this;
+  }
+
+  void EnterServiceMode() {
+    EXPECT_CALL(_mock, serviceModeHook(true));
+    Receive(dcc::make_reset_packet())->LeaveCutout()->Execute();
+  }
+
+  void Logon() {
+    EXPECT_CALL(_mock, readCv(DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 0u))
+      .WillRepeatedly(Return(_cvs[DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 0uz]));
+    EXPECT_CALL(_mock, readCv(DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 1u))
+      .WillRepeatedly(Return(_cvs[DCC_RX_LOGON_ADDRESS_CV_ADDRESS + 1uz]));
+
+    // Enable
+    Receive(dcc::make_logon_enable_packet(dcc::AddressGroup::Now, _cid, _sid));
+  }
+
+  dcc::Packet TinkerWithPacketLength(dcc::Packet packet) const {
+    packet.back() = RandomInterval<uint8_t>(0u, 255u);
+    packet.push_back(dcc::exor({cbegin(packet), cend(packet)}));
+    return packet;
+  }
+
+  // Initialize additional mock (e.g. one to compare against)
+  template<typename Mock>
+  void InitMock(Mock& mock) {
+    ON_CALL(mock, readCv(_)).WillByDefault([this](uint32_t cv_addr) {
+      return _cvs[cv_addr];
+    });
+    mock.init();
+  }
+
+  template<std::unsigned_integral T>
+  static T RandomInterval(T min, T max) {
+    std::mt19937 gen{std::random_device{}()};
+    std::uniform_int_distribution<T> dis{min, max};
+    return dis(gen);
+  }
+
+  /// \todo this needs to go
+  void ReceiveAndExecute(dcc::Packet const& packet) {
+    Receive(packet)->LeaveCutout()->Execute();
+  }
+
+  /// \todo this needs to go
+  void ReceiveAndExecuteTwice(dcc::Packet const& packet) {
+    ReceiveAndExecute(packet);
+    ReceiveAndExecute(packet);
+  }
+
+  NiceMock<BasicRxMock<Cfg>> _mock;
+  dcc::Addresses _addrs{
+    .primary = {.value = 3u, .type = dcc::Address::BasicLoco},
+    .consist = {.value = 4u, .type = dcc::Address::BasicLoco},
+    .logon = {.value = 1000u, .type = dcc::Address::ExtendedLoco}};
+  std::array<uint8_t, smath::pow(2uz, 16uz)> _cvs{};
+  uint32_t _did{0xAABBCCDDu};
+  uint16_t _cid{0xABCDu};
+  uint8_t _sid{0x2Au};
+};
+
+using RxTest = BasicRxTest<>;
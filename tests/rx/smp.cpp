@@ -0,0 +1,14 @@
+#include "rx_test.hpp"
+
+using SmpTest = BasicRxTest<dcc::rx::Config{.smp = true}>;
+
+TEST_F(SmpTest, packet_end_blocks_execution) {
+  Receive(make_function_group_f4_f0_packet(_addrs.primary, 0u));
+  EXPECT_TRUE(_mock.packetEnd());
+  EXPECT_FALSE(_mock.execute());
+
+  EXPECT_CALL(_mock, function(_addrs.primary.value, _, _));
+  LeaveCutout();
+  EXPECT_FALSE(_mock.packetEnd());
+  EXPECT_TRUE(_mock.execute());
+}
@@ -0,0 +1,58 @@
+#include "rx_test.hpp"
+
+using StatisticsTest = BasicRxTest<dcc::rx::Config{.statistics = true}>;
+
+TEST_F(StatisticsTest, count_errors) {
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, 0u)};
+
+  // Invalid timing
+  _mock.receive(dcc::rx::Bit1Min - 1u);
+  EXPECT_EQ(_mock.statistics().invalid_timings, 1u);
+
+  // Too short preamble
+  for (auto i{0uz}; i < DCC_RX_MIN_PREAMBLE_BITS; ++i)
+    _mock.receive(dcc::rx::Bit1);
+  _mock.receive(dcc::rx::Bit0);
+  EXPECT_EQ(_mock.statistics().preamble_aborts, 1u);
+
+  // Invalid checksum
+  auto invalid_packet{packet};
+  invalid_packet.back() = static_cast<uint8_t>(~invalid_packet.back());
+  Receive(invalid_packet)->LeaveCutout();
+  EXPECT_EQ(_mock.statistics().checksum_errors, 1u);
+  EXPECT_EQ(_mock.statistics().packets_accepted, 0u);
+}
+
+TEST_F(StatisticsTest, count_packets) {
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, 0u)};
+
+  // Overflow deque
+  for (auto i{0uz}; i < DCC_RX_DEQUE_SIZE + 2uz; ++i)
+    Receive(packet)->LeaveCutout();
+  auto statistics{_mock.statistics()};
+  EXPECT_EQ(statistics.packets_accepted, DCC_RX_DEQUE_SIZE);
+  EXPECT_EQ(statistics.deque_overflows, 2u);
+  EXPECT_EQ(statistics.packets_executed, 0u);
+
+  while (_mock.execute());
+  statistics = _mock.statistics();
+  EXPECT_EQ(statistics.packets_executed, DCC_RX_DEQUE_SIZE);
+  EXPECT_EQ(statistics.invalid_timings, 0u);
+  EXPECT_EQ(statistics.preamble_aborts, 0u);
+  EXPECT_EQ(statistics.checksum_errors, 0u);
+}
+
+TEST_F(StatisticsTest, cutouts_are_no_errors) {
+  auto const packet{make_function_group_f4_f0_packet(_addrs.primary, 0u)};
+
+  // Edge which ends the cutout looks like a 0-bit at the start of a preamble
+  for (auto i{0uz}; i < 10uz; ++i) {
+    Receive(packet);
+    _mock.receive(dcc::bidi::TCS);
+    _mock.receive(dcc::bidi::TCE - dcc::bidi::TCS);
+  }
+  auto const statistics{_mock.statistics()};
+  EXPECT_EQ(statistics.packets_accepted, 10u);
+  EXPECT_EQ(statistics.preamble_aborts, 0u);
+  EXPECT_EQ(statistics.invalid_timings, 0u);
+}
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <dcc/dcc.hpp>
+
+namespace {
+
+// Reference implementation using range compares
+template<dcc::rx::TimingWindows Ws = dcc::rx::TimingWindows{}>
+dcc::Bit time2bit_reference(uint32_t time) {
+  if (time >= Ws.bit1_min && time <= Ws.bit1_max) return dcc::_1;
+  else if (time >= Ws.bit0_min && time <= Ws.bit0_max) return dcc::_0;
+  else return dcc::Invalid;
+}
+
+} // namespace
+
+TEST(time2bit, default_timing_windows) {
+  for (auto t{0u}; t <= 2u * dcc::rx::Bit0MaxAnalog; ++t)
+    EXPECT_EQ(dcc::rx::time2bit(t), time2bit_reference(t));
+  EXPECT_EQ(dcc::rx::time2bit(std::numeric_limits<uint32_t>::max()),
+            dcc::Invalid);
+}
+
+TEST(time2bit, custom_timing_windows) {
+  static constexpr dcc::rx::TimingWindows ws{
+    .bit1_min = 55u, .bit1_max = 61u, .bit0_min = 95u, .bit0_max = 12000u};
+  for (auto t{0u}; t <= 2u * ws.bit0_max; ++t)
+    EXPECT_EQ(dcc::rx::time2bit<ws>(t), time2bit_reference<ws>(t));
+}
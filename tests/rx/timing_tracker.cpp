@@ -0,0 +1,120 @@
+#include "rx_test.hpp"
+
+namespace {
+
+using TimingTracker =
+  dcc::rx::TimingTracker<dcc::rx::TimingWindows{}, 4u>;
+
+constexpr dcc::rx::Config adaptive_timing_cfg{.adaptive_timing = 4u};
+
+// Shorten both halves of a 0-bit in a byte until they look like a 1-bit
+void ShortenBit(dcc::tx::Timings& timings, size_t byte, size_t bit) {
+  auto const i{dcc::tx::Config{}.num_preamble * 2uz + byte * 18uz + 2uz +
+               (7uz - bit) * 2uz};
+  ASSERT_EQ(timings[i], dcc::rx::Bit0);
+  timings[i] = timings[i + 1uz] = 63u;
+}
+
+} // namespace
+
+TEST(TimingTrackerTest, standard_windows_until_learned) {
+  TimingTracker tracker;
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit1Min), dcc::_1);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit1Max), dcc::_1);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit0Min), dcc::_0);
+  tracker.bit1(58u);
+  tracker.bit1(58u);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit1Min), dcc::_1);
+}
+
+TEST(TimingTrackerTest, learned_windows) {
+  TimingTracker tracker;
+  for (auto t : {57u, 58u, 58u, 57u, 70u, 70u}) tracker.bit1(t);
+  EXPECT_EQ(tracker.time2bit(53u), dcc::Invalid);
+  EXPECT_EQ(tracker.time2bit(54u), dcc::_1);
+  EXPECT_EQ(tracker.time2bit(62u), dcc::_1);
+  EXPECT_EQ(tracker.time2bit(63u), dcc::Invalid);
+
+  for (auto t : {100u, 101u, 101u, 100u, 99u, 99u}) tracker.bit0(t);
+  EXPECT_EQ(tracker.time2bit(95u), dcc::Invalid);
+  EXPECT_EQ(tracker.time2bit(96u), dcc::_0);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit0MaxAnalog), dcc::_0);
+}
+
+TEST(TimingTrackerTest, learned_windows_never_exceed_standard_ones) {
+  TimingTracker tracker;
+  for (auto i{0uz}; i < 6uz; ++i) tracker.bit1(dcc::rx::Bit1Max);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit1Max + 1u), dcc::Invalid);
+  for (auto i{0uz}; i < 6uz; ++i) tracker.bit0(dcc::rx::Bit0Min);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit0Min - 1u), dcc::Invalid);
+}
+
+TEST(TimingTrackerTest, asymmetric_bits) {
+  TimingTracker tracker;
+  for (auto i{0uz}; i < 6uz; ++i) tracker.bit1(i % 2uz ? 61u : 55u);
+  EXPECT_EQ(tracker.time2bit(50u), dcc::Invalid);
+  EXPECT_EQ(tracker.time2bit(55u), dcc::_1);
+  EXPECT_EQ(tracker.time2bit(61u), dcc::_1);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit1Max + 1u), dcc::Invalid);
+
+  for (auto i{0uz}; i < 6uz; ++i) tracker.bit0(i % 2uz ? 106u : 94u);
+  EXPECT_EQ(tracker.time2bit(89u), dcc::Invalid);
+  EXPECT_EQ(tracker.time2bit(94u), dcc::_0);
+  EXPECT_EQ(tracker.time2bit(106u), dcc::_0);
+}
+
+TEST(TimingTrackerTest, stretched_0_bits_are_ignored) {
+  TimingTracker tracker;
+  for (auto i{0uz}; i < 6uz; ++i) tracker.bit0(500u);
+  EXPECT_EQ(tracker.time2bit(dcc::rx::Bit0Min), dcc::_0);
+}
+
+using AdaptiveTimingTest = BasicRxTest<adaptive_timing_cfg>;
+
+TEST_F(AdaptiveTimingTest, rejects_misclassified_bits) {
+  // Turn F4-F0 off into F3 on by misclassifying two 0-bits which cancel each
+  // other out in the checksum
+  auto timings{dcc::tx::packet2timings(
+    make_function_group_f4_f0_packet(_addrs.primary, 0b0'0000u))};
+  ShortenBit(timings, 1uz, 2uz);
+  ShortenBit(timings, 2uz, 2uz);
+
+  // Standard windows accept the corrupted packet
+  NiceMock<RxMock> standard;
+  InitMock(standard);
+  EXPECT_CALL(standard, function(_addrs.primary.value, 0b11111u, 0b0'1000u));
+  for (auto const t : timings) standard.receive(t);
+  standard.receive(dcc::rx::Bit1);
+  standard.execute();
+
+  // Adaptive timing rejects it
+  EXPECT_CALL(_mock, function(_, _, _)).Times(0);
+  for (auto const t : timings) _mock.receive(t);
+  LeaveCutout()->Execute();
+}
+
+TEST_F(AdaptiveTimingTest, accepts_clean_signal) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state)).Times(2);
+  for (auto i{0uz}; i < 2uz; ++i)
+    ReceiveAndExecute(make_function_group_f4_f0_packet(_addrs.primary, state));
+}
+
+TEST_F(AdaptiveTimingTest, accepts_asymmetric_command_station) {
+  auto state{RandomInterval<uint8_t>(0b0'0000u, 0b1'1111u)};
+  auto timings{dcc::tx::packet2timings(
+    make_function_group_f4_f0_packet(_addrs.primary, state))};
+
+  // First halves short, second ones long
+  for (auto i{0uz}; i < size(timings); i += 2uz) {
+    auto const d{timings[i] == dcc::rx::Bit1 ? 3u : 6u};
+    timings[i] -= d;
+    timings[i + 1uz] += d;
+  }
+
+  EXPECT_CALL(_mock, function(_addrs.primary.value, 0b11111u, state)).Times(2);
+  for (auto i{0uz}; i < 2uz; ++i) {
+    for (auto const t : timings) _mock.receive(t);
+    LeaveCutout()->Execute();
+  }
+}